@@ -15,6 +15,7 @@
 #endif /*__TURBOC__*/
 
 #include "fxf.h"
+#include "platform/maxmem.h"
 
 #if !defined(Nil) && !defined(New) && !defined(nNew)
 #  define Nil(type)      (type *)0
@@ -46,19 +47,32 @@
 /* FiXed and Fast malloc, free
  * As the name tells: this code implements on top of traditional
  * malloc/realloc/free a fast version, that relies on a lot of
- * allocation/delallocation of fixed sized blocks of memory. For
- * each size of memory we keep a head pointer and all freed chunks
- * of memory is threaded on this list. If memory of this size
- * is requested, we drag it from the list, otherwise we carf it
- * from larger preallocated (via malloc) chunks of memory. If
- * the sizes between allocation and deallocation vary to often,
- * this package is lost in fragmented memory.
+ * allocation/delallocation of fixed sized blocks of memory.
+ * The arena is divided into pages of equal size. Each page holds chunks
+ * of a single size only; for each size of memory we keep the list of its
+ * pages that have free chunks. Freed chunks are threaded on a list per
+ * page, so that the chunks of a size stay close to each other. Once all
+ * chunks of a page have been freed, the page can be used for any size
+ * again; this is what makes compressing the hash table return memory.
+ * Popeye's worker processes each have their own copy of the arena, so
+ * there is no need for caches per thread.
  */
 
+typedef struct PageHead {
+    struct PageHead *Next;    /* next page with free chunks of the same
+                               * size; next free page */
+    struct PageHead *Prev;
+    char *FreeHead;           /* chunks freed */
+    char *Unused;             /* chunks not yet allocated start here */
+    size_t Size;              /* size of the chunks */
+    unsigned long UsedCount;
+} PageHead;
+
 typedef struct {
     unsigned long  MallocCount;
-    unsigned long  FreeCount;
-    char *    FreeHead;
+    unsigned long  FreeCount;   /* free chunks in the pages of this size */
+    unsigned long  PageCount;
+    PageHead *     Partial;     /* pages with free chunks */
 } SizeHead;
 
 #if defined(DOS)
@@ -91,6 +105,15 @@ enum
   fxfMINSIZE = sizeof(size_t)
 };
 
+/* Range of the page size; the page size is a power of 2 so that the page
+ * of a chunk can be determined by masking the chunk's address */
+#define fxfMINPAGESIZE  (size_t)4096
+#if defined(SEGMENTED)
+#define fxfMAXPAGESIZE  (size_t)8192
+#else
+#define fxfMAXPAGESIZE  (size_t)65536
+#endif
+
 static SizeHead SizeData[fxfMAXSIZE+1];
 
 #if defined(SEGMENTED)
@@ -104,89 +127,58 @@ static char *Arena= Nil(char);
 #endif /*SEGMENTED*/
 
 static size_t GlobalSize;
+static size_t PageSize;
+
+/* pages not yet carved from the current segment lie between these */
 static char *BotFreePtr;
 static char *TopFreePtr;
 
-#undef FREEMAP
-
-
-#if defined(FREEMAP) && !defined(SEGMENTED)
-static unsigned int *FreeMap;
-#define  Bit(x)    (1<<((x)&31))
-#define  LeftMask(x)  (-1<<((x)&31))
-#define  SetFreeBit(x)  FreeMap[(x)>>5]|= Bit(x)
-#define ClrFreeBit(x)  FreeMap[(x)>>5]&= ~Bit(x)
-#define  MAC_SetRange(x,l)  {                       \
-    int xi= (x)>>5, y= x+l, yi= (y)>>5;             \
-    if (xi==yi)                                     \
-      FreeMap[xi]|= LeftMask(x) & (~LeftMask(y));   \
-    else {                                          \
-      int i;                                        \
-      FreeMap[xi]|= LeftMask(x);                    \
-      FreeMap[yi]|= ~LeftMask(y);                   \
-      yi--;                                         \
-      for (i=xi+1; i<yi; i++)                       \
-        FreeMap[i]= -1;                             \
-    }                                               \
-  }
-#define  MAC_ClrRange(x,l)  {                       \
-    int xi= (x)>>5, y= x+l, yi= (y)>>5;             \
-    if (xi==yi)                                     \
-      FreeMap[xi]&= (~LeftMask(x)) | LeftMask(y);   \
-    else {                                          \
-      int i;                                        \
-      FreeMap[xi]&= ~LeftMask(x);                   \
-      FreeMap[yi]&= LeftMask(y);                    \
-      yi--;                                         \
-      for (i=xi+1; i<yi; i++)                       \
-        FreeMap[i]= 0;                              \
-    }                                               \
-  }
+/* pages that have been given back */
+static PageHead *FreePages;
+static unsigned long FreePageCount;
+static unsigned long PageCount;
 
-void  SetRange(int x, int l)  {
-  int xi= (x)>>5, y= x+l, yi= (y)>>5;
-  if (xi==yi)
-    FreeMap[xi]|= LeftMask(x) & (~LeftMask(y));
-  else {
-    int i;
-    FreeMap[xi]|= LeftMask(x);
-    FreeMap[yi]|= ~LeftMask(y);
-    yi--;
-    for (i=xi+1; i<yi; i++)
-      FreeMap[i]= -1;
-  }
-}
+#define PageOf(ptr)  ((PageHead *)((size_t)(ptr) & ~(PageSize-1)))
+#define PageEnd(pg)  ((char *)(pg)+PageSize)
+#define IsFull(pg)   ((pg)->FreeHead==Nil(char) \
+                      && (pg)->Unused+(pg)->Size>PageEnd(pg))
 
-void ClrRange(int x, int l)  {
-  int xi= (x)>>5, y= x+l, yi= (y)>>5;
-  if (xi==yi)
-    FreeMap[xi]&= (~LeftMask(x)) | LeftMask(y);
-  else {
-    int i;
-    FreeMap[xi]&= ~LeftMask(x);
-    FreeMap[yi]&= LeftMask(y);
-    yi--;
-    for (i=xi+1; i<yi; i++)
-      FreeMap[i]= 0;
-  }
+/* Align the pages of the current segment to the page size
+ */
+static void AlignBotFreePtr(void) {
+  BotFreePtr= (char *)(((size_t)BotFreePtr+PageSize-1) & ~(PageSize-1));
+  if (BotFreePtr>TopFreePtr)
+    BotFreePtr= TopFreePtr;
 }
 
-void PrintFreeMap(FILE *f) {
-  int i;
-  for (i=0; i<GlobalSize; i++) {
-    if (i % 80 == 0)
-      fputc('\n', f);
-    if (FreeMap[i>>5]&Bit(i)) {
-      fputc('.', f);
-    }
-    else
-      fputc(' ', f);
-  }
+/* Determine the page size for an arena
+ * @param Size size of the arena
+ * @return page size
+ */
+static size_t ChoosePageSize(size_t Size) {
+  /* enough pages for the various sizes, but not too many partially used
+   * ones */
+  size_t result= fxfMINPAGESIZE;
+  while (result<fxfMAXPAGESIZE && 2*result<=Size/64)
+    result*= 2;
+  return result;
 }
+
+static void ResetPages(void) {
+#if defined(SEGMENTED)
+  CurrentSeg= 0;
+  BotFreePtr= Arena[CurrentSeg];
+  TopFreePtr= Arena[CurrentSeg]+ARENA_SEG_SIZE;
 #else
-#  define  SetRange(x,l)
-#  define  ClrRange(x,l)
-#endif /*FREEMAP, !SEGMENTED*/
+  BotFreePtr= Arena;
+  TopFreePtr= Arena+GlobalSize;
+#endif /*SEGMENTED*/
+  AlignBotFreePtr();
+
+  FreePages= Nil(PageHead);
+  FreePageCount= 0;
+  PageCount= 0;
+}
 
 int fxfInit(size_t Size) {
 #if defined(LOG)
@@ -208,32 +200,23 @@ int fxfInit(size_t Size) {
     }
     asize-= ARENA_SEG_SIZE;
   }
-  CurrentSeg= 0;
-  BotFreePtr= Arena[CurrentSeg];
-  TopFreePtr= Arena[CurrentSeg]+ARENA_SEG_SIZE;
   GlobalSize= ArenaSegCnt*ARENA_SEG_SIZE;
 #else
   if (Arena)
-    free(Arena);
-  if ((Arena=nNew(Size, char)) == Nil(char)) {
+    platform_free_table_memory(Arena, GlobalSize);
+  if ((Arena=platform_allocate_table_memory(Size, false)) == Nil(char)) {
     ERROR_LOG2("%s: Sorry, cannot allocate arena of %lu bytes\n",
                myname, Size);
     BotFreePtr= Arena;
+    TopFreePtr= Arena;
     GlobalSize= 0;
     return -1;
   }
-  BotFreePtr= Arena;
-  TopFreePtr= Arena+Size;
   GlobalSize= Size;
 #endif /*SEGMENTED*/
 
-#if defined(FREEMAP) && !defined(SEGMENTED)
-  if (FreeMap) {
-    free(FreeMap);
-  }
-  FreeMap= nNew((Size+31)>>5, unsigned int);
-  memset(FreeMap, 0, Size>>3);
-#endif /*FREEMAP, !SEGMENTED*/
+  PageSize= ChoosePageSize(GlobalSize);
+  ResetPages();
 
   memset(SizeData, '\0', sizeof(SizeData));
 
@@ -249,20 +232,12 @@ int fxfInitialised(void)
 #endif
 }
 
+/* Reset the internal data structures to the state that was reached
+ * after the latest call to fxfInit(); takes the same time however many
+ * chunks have been allocated */
 void fxfReset(void)
 {
-#if defined(SEGMENTED)
-  CurrentSeg= 0;
-  BotFreePtr= Arena[CurrentSeg];
-  TopFreePtr= Arena[CurrentSeg]+ARENA_SEG_SIZE;
-#else
-  BotFreePtr= Arena;
-  TopFreePtr= Arena+GlobalSize;
-
-#if defined(FREEMAP)
-  memset(FreeMap, 0, GlobalSize>>3);
-#endif /*FREEMAP*/
-#endif /*SEGMENTED*/
+  ResetPages();
 
 #if !defined(NDEBUG)
   {
@@ -288,16 +263,80 @@ void fxfReset(void)
 #define  GetNextPtr(ptr)       *(char **)ALIGN(ptr)
 #define  PutNextPtr(dst, ptr)  *(char **)ALIGN(dst)= ptr
 
-#define TMDBG(x) {}
+/* the chunks of a page start after the page head, at an aligned address */
+#define FirstChunk(pg)  ((char *)(pg)+ALIGN(sizeof(PageHead)))
+
+/* Provide a page that isn't used for any size
+ * @return the page; Nil if the arena is exhausted
+ */
+static PageHead *NewPage(void) {
+  PageHead *result;
+
+  if (FreePages) {
+    result= FreePages;
+    FreePages= result->Next;
+    FreePageCount--;
+  }
+  else {
+    if ((size_t)(TopFreePtr-BotFreePtr)<PageSize) {
+#if defined(SEGMENTED)
+      while ((CurrentSeg+1) < ArenaSegCnt) {
+        CurrentSeg+= 1;
+        BotFreePtr= Arena[CurrentSeg];
+        TopFreePtr= Arena[CurrentSeg]+ARENA_SEG_SIZE;
+        AlignBotFreePtr();
+        if ((size_t)(TopFreePtr-BotFreePtr)>=PageSize)
+          break;
+      }
+      if ((size_t)(TopFreePtr-BotFreePtr)<PageSize)
+        return Nil(PageHead);
+#else /*SEGMENTED*/
+      return Nil(PageHead);
+#endif /*!SEGMENTED*/
+    }
+    result= (PageHead *)BotFreePtr;
+    BotFreePtr+= PageSize;
+  }
+
+  PageCount++;
+  return result;
+}
+
+/* Give back a page whose chunks have all been freed
+ * @param pg the page
+ */
+static void ReleasePage(PageHead *pg) {
+  pg->Next= FreePages;
+  FreePages= pg;
+  FreePageCount++;
+  PageCount--;
+}
+
+static void LinkPartial(SizeHead *sh, PageHead *pg) {
+  pg->Prev= Nil(PageHead);
+  pg->Next= sh->Partial;
+  if (sh->Partial)
+    sh->Partial->Prev= pg;
+  sh->Partial= pg;
+}
+
+static void UnlinkPartial(SizeHead *sh, PageHead *pg) {
+  if (pg->Prev)
+    pg->Prev->Next= pg->Next;
+  else
+    sh->Partial= pg->Next;
+  if (pg->Next)
+    pg->Next->Prev= pg->Prev;
+}
 
 void *fxfAlloc(size_t size) {
 #if defined(LOG) || defined(DEBUG)
   static char const * const myname= "fxfAlloc";
 #endif
   SizeHead *sh;
+  PageHead *pg;
   char *ptr;
 
-  TMDBG(printf("fxfAlloc - size:%lu",size));
   DBG((stderr, "%s(%u) =", myname, (unsigned int)size));
 
   if (size<fxfMINSIZE)
@@ -315,58 +354,49 @@ void *fxfAlloc(size_t size) {
     size= ALIGNED_MINSIZE;
 
   sh= &SizeData[size];
-  if (sh->FreeHead) {
-    ptr= sh->FreeHead;
-    sh->FreeHead= GetNextPtr(ptr);
-    sh->FreeCount--;
-    sh->MallocCount++;
-    ClrRange((char *)ptr-Arena, size);
-    TMDBG(printf(" FreeCount:%lu ptr-Arena:%ld MallocCount:%lu\n",sh->FreeCount,(char*)ptr-Arena,sh->MallocCount));
+  pg= sh->Partial;
+  if (pg==Nil(PageHead)) {
+    /* we have to allocate a new page */
+    pg= NewPage();
+    if (pg==Nil(PageHead)) {
+      DBG((df, "%p\n", (void *)0));
+      return Nil(char);
+    }
+    pg->FreeHead= Nil(char);
+    pg->Unused= FirstChunk(pg);
+    pg->Size= size;
+    pg->UsedCount= 0;
+    LinkPartial(sh,pg);
+    sh->PageCount++;
+    sh->FreeCount+= (unsigned long)((PageEnd(pg)-FirstChunk(pg))/size);
+  }
+
+  if (pg->FreeHead) {
+    ptr= pg->FreeHead;
+    pg->FreeHead= GetNextPtr(ptr);
   }
   else {
-    /* we have to allocate a new piece */
-    size_t const sizeCurrentSeg = TopFreePtr-BotFreePtr;
-    TMDBG(printf(" sizeCurrentSeg:%lu",sizeCurrentSeg));
-    if (sizeCurrentSeg>=size) {
-      if (size&PTRMASK) {
-        /* not aligned */
-        ptr= BotFreePtr;
-        BotFreePtr+= size;
-      }
-      else {
-        /* aligned */
-        ptr= TopFreePtr-= size;
-      }
-      sh->MallocCount++;
-      TMDBG(printf(" current seg ptr-Arena:%ld MallocCount:%lu\n",(char*)ptr-Arena,sh->MallocCount));
-    }
-    else
-    {
-#if defined(SEGMENTED)
-      if ((CurrentSeg+1) < ArenaSegCnt) {
-        TMDBG(printf(" next seg"));
-        CurrentSeg+= 1;
-        BotFreePtr= Arena[CurrentSeg];
-        TopFreePtr= Arena[CurrentSeg]+ARENA_SEG_SIZE;
-        ptr= fxfAlloc(size);
-      }
-      else
-        ptr= Nil(char);
-#else /*SEGMENTED*/
-      ptr= Nil(char);
-#endif /*!SEGMENTED*/
-      TMDBG(printf(" ptr:%p\n",ptr));
-    }
+    ptr= pg->Unused;
+    pg->Unused+= size;
   }
-  DBG((df, "%p\n", ptr));
+
+  pg->UsedCount++;
+  sh->MallocCount++;
+  sh->FreeCount--;
+
+  if (IsFull(pg))
+    UnlinkPartial(sh,pg);
+
+  DBG((df, "%p\n", (void *)ptr));
   return ptr;
 }
 
 void fxfFree(void *ptr, size_t size) {
   static char const * const myname= "fxfFree";
   SizeHead *sh;
+  PageHead *pg;
+  int wasFull;
 
-  TMDBG(printf("fxfFree - ptr-Arena:%ld size:%lu",(char*)ptr-Arena,size));
   DBG((df, "%s(%p, %u)\n", myname, ptr, (unsigned int)size));
   if (size > fxfMAXSIZE) {
     fprintf(stderr, "%s: size=%u >= %u\n",
@@ -378,42 +408,27 @@ void fxfFree(void *ptr, size_t size) {
   if ((size&PTRMASK) && size<ALIGNED_MINSIZE)
     size= ALIGNED_MINSIZE;
   sh= &SizeData[size];
-  if (size&PTRMASK) {
-    /* unaligned size */
-    TMDBG(printf(" BotFreePtr-ptr:%ld",BotFreePtr-(char *)ptr));
-    if ((char *)ptr+size == BotFreePtr) {
-      BotFreePtr-= size;
-      TMDBG(printf(" BotFreePtr sizeCurrentSeg:%lu",TopFreePtr-BotFreePtr));
-      sh->MallocCount-= 1;
-    }
-    else {
-      SetRange((char *)ptr-Arena,size);
-      *(char **)ALIGN(ptr)= sh->FreeHead;
-      sh->FreeHead= ptr;
-      sh->FreeCount+= 1;
-      sh->MallocCount-= 1;
-      TMDBG(printf(" FreeCount:%lu",sh->FreeCount));
-    }
+  pg= PageOf(ptr);
+  assert(pg->Size==size);
+
+  wasFull= IsFull(pg);
+
+  PutNextPtr(ptr, pg->FreeHead);
+  pg->FreeHead= ptr;
+  pg->UsedCount--;
+  sh->MallocCount--;
+  sh->FreeCount++;
+
+  if (pg->UsedCount==0) {
+    /* the page can now be used for any size */
+    if (!wasFull)
+      UnlinkPartial(sh,pg);
+    sh->PageCount--;
+    sh->FreeCount-= (unsigned long)((PageEnd(pg)-FirstChunk(pg))/size);
+    ReleasePage(pg);
   }
-  else {
-    /* aligned size */
-    TMDBG(printf(" ptr-TopFreePtr:%ld",(char *)ptr-TopFreePtr));
-    if ((char *)ptr == TopFreePtr) {
-      TopFreePtr+= size;
-      TMDBG(printf(" TopFreePtr sizeCurrentSeg:%lu",TopFreePtr-BotFreePtr));
-      sh->MallocCount-= 1;
-    }
-    else {
-      SetRange((char *)ptr-Arena,size);
-      *(char **)ptr= sh->FreeHead;
-      sh->FreeHead= ptr;
-      sh->FreeCount+= 1;
-      sh->MallocCount-= 1;
-      TMDBG(printf(" FreeCount:%lu",sh->FreeCount));
-    }
-  }
-  TMDBG(printf(" MallocCount:%lu",sh->MallocCount));
-  TMDBG(printf("\n"));
+  else if (wasFull)
+    LinkPartial(sh,pg);
 }
 
 void *fxfReAlloc(void *ptr, size_t OldSize, size_t NewSize) {
@@ -441,13 +456,7 @@ size_t fxfTotal() {
 
 void fxfInfo(FILE *f) {
   size_t const one_kilo = 1<<10;
-  size_t const sizeCurrentSeg = (TopFreePtr-BotFreePtr);
-  size_t const sizeArenaUsed =
-          GlobalSize-sizeCurrentSeg
-#if defined(SEGMENTED)
-          - (ArenaSegCnt-CurrentSeg-1)*ARENA_SEG_SIZE
-#endif /*SEGMENTED*/
-      ;
+  size_t const sizeArenaUsed = (PageCount+FreePageCount)*PageSize;
   assert(GlobalSize/one_kilo<=ULONG_MAX);
   fprintf(f, "fxfArenaSize = %lu kB\n",
           (unsigned long)(GlobalSize/one_kilo));
@@ -455,31 +464,37 @@ void fxfInfo(FILE *f) {
   fprintf(f, "fxfArenaUsed = %lu kB\n",
           (unsigned long)(sizeArenaUsed/one_kilo));
   fprintf(f, "fxfMAXSIZE   = %u B\n", (unsigned int)fxfMAXSIZE);
+  fprintf(f, "fxfPageSize  = %u B\n", (unsigned int)PageSize);
+  fprintf(f, "fxfPages     = %lu used, %lu free\n", PageCount, FreePageCount);
 
   {
     SizeHead const *hd = SizeData;
     unsigned long nrUsed = 0;
     unsigned long nrFree = 0;
+    unsigned long nrPages = 0;
     size_t UsedBytes = 0;
     size_t FreeBytes = 0;
 
     unsigned int i;
-    fprintf(f, "%12s  %10s%10s\n", "Size", "MallocCnt", "FreeCnt");
+    fprintf(f, "%12s  %10s%10s%10s\n", "Size", "MallocCnt", "FreeCnt", "Pages");
     for (i=0; i<=fxfMAXSIZE; i++,hd++) {
       if (hd->MallocCount+hd->FreeCount>0) {
-        fprintf(f, "%12u  %10lu%10lu\n", i, hd->MallocCount, hd->FreeCount);
+        fprintf(f, "%12u  %10lu%10lu%10lu\n",
+                i, hd->MallocCount, hd->FreeCount, hd->PageCount);
         nrUsed+= hd->MallocCount;
         UsedBytes+= hd->MallocCount*i;
         nrFree+= hd->FreeCount;
         FreeBytes+= hd->FreeCount*i;
+        nrPages+= hd->PageCount;
       }
     }
-    fprintf(f, "%12s  %10lu%10lu\n", "Total:", nrUsed, nrFree);
+    fprintf(f, "%12s  %10lu%10lu%10lu\n", "Total:", nrUsed, nrFree, nrPages);
     assert(UsedBytes/one_kilo<=ULONG_MAX);
     assert(FreeBytes/one_kilo<=ULONG_MAX);
-    fprintf(f, "%12s  %10lu%10lu\n", "Total kB:",
+    fprintf(f, "%12s  %10lu%10lu%10lu\n", "Total kB:",
             (unsigned long)(UsedBytes/one_kilo),
-            (unsigned long)(FreeBytes/one_kilo));
+            (unsigned long)(FreeBytes/one_kilo),
+            (unsigned long)(nrPages*PageSize/one_kilo));
   }
 }
 
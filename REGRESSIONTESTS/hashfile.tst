@@ -0,0 +1,72 @@
+solve with -hashfile to make sure that problems that only differ in
+the parameters of a condition don't share their file
+
+     implicit chameleon sequence
+
++---a---b---c---d---e---f---g---h---+
+|                                   |
+8   .   .   .   .   .   .   .   .   8
+|                                   |
+7   .   .   .   .   .   .   .   .   7
+|                                   |
+6   .  -P   .   .  -B   .   K   .   6
+|                                   |
+5   .   .   .  -K   .   .   .   .   5
+|                                   |
+4   .   .   .   .   .   .   .   .   4
+|                                   |
+3   .   .   .   .   .   Q   .   .   3
+|                                   |
+2   .   .   .   .   .   .   .  -R   2
+|                                   |
+1   .   .   .   B   .   .   .   .   1
+|                                   |
++---a---b---c---d---e---f---g---h---+
+  h#2                         3 + 4
+           Circe Chameleon
+
+  1.Kd5-e5 Bd1-c2   2.Be6-d5 Qf3-f6 #
+  add_to_move_generation_stack:      174700
+                     play_move:       65571
+ is_white_king_square_attacked:       22653
+ is_black_king_square_attacked:       65392
+
+solution finished.
+
+
+
+     explicit chameleon sequence
+
++---a---b---c---d---e---f---g---h---+
+|                                   |
+8   .   .   .   .   .   .   .   .   8
+|                                   |
+7   .   .   .   .   .   .   .   .   7
+|                                   |
+6   .  -P   .   .  -B   .   K   .   6
+|                                   |
+5   .   .   .  -K   .   .   .   .   5
+|                                   |
+4   .   .   .   .   .   .   .   .   4
+|                                   |
+3   .   .   .   .   .   Q   .   .   3
+|                                   |
+2   .   .   .   .   .   .   .  -R   2
+|                                   |
+1   .   .   .   B   .   .   .   .   1
+|                                   |
++---a---b---c---d---e---f---g---h---+
+  h#2                         3 + 4
+    Circe Chameleon Q->R->B->S->Q
+
+  1.Kd5-c4 Bd1-e2 +   2.Kc4-b4 Qf3-a3 #
+  1.Kd5-c5 Bd1-e2   2.Kc5-b4 Qf3-a3 #
+  1.Kd5-e5 Bd1-c2   2.Be6-d5 Qf3-f6 #
+  add_to_move_generation_stack:      174707
+                     play_move:       65733
+ is_white_king_square_attacked:       22652
+ is_black_king_square_attacked:       65556
+
+solution finished.
+
+
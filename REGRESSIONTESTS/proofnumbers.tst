@@ -0,0 +1,260 @@
+the attacker's moves are tested by proof-number search; the
+solutions must be the same as those found by depth-first search
+
+                #2.5
+
++---a---b---c---d---e---f---g---h---+
+|                                   |
+8  -K   .   .   .  -S   .   .   .   8
+|                                   |
+7   P   .   .   .   .   .   .   .   7
+|                                   |
+6   K   .  -P   .   S   .   .   .   6
+|                                   |
+5   .   .   .   .   .   .   .   .   5
+|                                   |
+4   .   .   .   .   .   .   .   .   4
+|                                   |
+3   .   .   P   .   .   .   .   .   3
+|                                   |
+2   .   .   .   .   .   .   .   .   2
+|                                   |
+1   .   .   .   .   .   .   .   .   1
+|                                   |
++---a---b---c---d---e---f---g---h---+
+  #3                          4 + 3
+
+   1.c3-c4 ! threat:
+          2.c4-c5 zugzwang.
+              2...Se8-c7 +
+                  3.Se6*c7 #
+              2...Se8-d6
+                  3.Se6-c7 #
+              2...Se8-f6
+                  3.Se6-c7 #
+              2...Se8-g7
+                  3.Se6-c7 #
+      1...c6-c5
+          2.Ka6-b6 zugzwang.
+              2...Se8-c7
+                  3.Se6*c7 #
+              2...Se8-d6
+                  3.Se6-c7 #
+              2...Se8-f6
+                  3.Se6-c7 #
+              2...Se8-g7
+                  3.Se6-c7 #
+
+   1.Ka6-b6 ! zugzwang.
+      1...c6-c5
+          2.c3-c4 zugzwang.
+              2...Se8-c7
+                  3.Se6*c7 #
+              2...Se8-d6
+                  3.Se6-c7 #
+              2...Se8-f6
+                  3.Se6-c7 #
+              2...Se8-g7
+                  3.Se6-c7 #
+      1...Se8-c7
+          2.Se6*c7 #
+      1...Se8-d6
+          2.Se6-c7 #
+      1...Se8-f6
+          2.Se6-c7 #
+      1...Se8-g7
+          2.Se6-c7 #
+
+  add_to_move_generation_stack:        2218
+                     play_move:        1553
+ is_white_king_square_attacked:         883
+ is_black_king_square_attacked:         778
+
+solution finished.
+
+
+
+           #2 with setplay
+
++---a---b---c---d---e---f---g---h---+
+|                                   |
+8   .  -K   .   .   .   .   .   .   8
+|                                   |
+7   .   .   .   .   .   .   .   .   7
+|                                   |
+6   K   .   R   .   .   .   .   .   6
+|                                   |
+5   .   .  -P   .   .   .   .   .   5
+|                                   |
+4   .   .   .   .   .   .   .   .   4
+|                                   |
+3   .   .   .   .   .   .   .   .   3
+|                                   |
+2   .   .   .   .   .   .   .   .   2
+|                                   |
+1   .   .   .   .   .   .   .   .   1
+|                                   |
++---a---b---c---d---e---f---g---h---+
+  #2                          2 + 2
+
+      1...Kb8-a8
+          2.Rc6-c8 #
+
+   1.Rc6*c5 ! zugzwang.
+      1...Kb8-a8
+          2.Rc5-c8 #
+
+  add_to_move_generation_stack:         274
+                     play_move:         160
+ is_white_king_square_attacked:          46
+ is_black_king_square_attacked:         162
+
+solution finished.
+
+
+
+                 s#2
+
++---a---b---c---d---e---f---g---h---+
+|                                   |
+8   .   .   .   .   .   .   .   .   8
+|                                   |
+7   .   .   .   .   .   .   .   .   7
+|                                   |
+6   .   .   .   .   .   .   .   .   6
+|                                   |
+5   .   .   .   .   .   .   .   .   5
+|                                   |
+4   .  -P   .   .   .   .   Q   .   4
+|                                   |
+3  -K   .   .   .   .   .   .   .   3
+|                                   |
+2  -P   .   .   .   .   .   .   .   2
+|                                   |
+1   K   .   .   .   .   .   .   .   1
+|                                   |
++---a---b---c---d---e---f---g---h---+
+  s#2                         2 + 3
+
+   1.Qg4-d1 ! zugzwang.
+      1...b4-b3
+          2.Qd1-g4
+              2...b3-b2 #
+
+  add_to_move_generation_stack:        3156
+                     play_move:        1618
+ is_white_king_square_attacked:        1619
+ is_black_king_square_attacked:         871
+
+solution finished.
+
+
+
+ #3.5 with restricted threat length
+
++---a---b---c---d---e---f---g---h---+
+|                                   |
+8   .   .   .   .  -K   .   .   .   8
+|                                   |
+7   .  -P  -P   .   .  -P  -P   .   7
+|                                   |
+6   .   .   .   .   .   .   .   .   6
+|                                   |
+5  -B   .   B   .  -P   B   .   R   5
+|                                   |
+4  -R   .   .   .   .   .   .   .   4
+|                                   |
+3  -P  -P   .   .   .   .   S   .   3
+|                                   |
+2   .   .   .   .   K   .   .   .   2
+|                                   |
+1   R   .   .   .   .   .   .   .   1
+|                                   |
++---a---b---c---d---e---f---g---h---+
+  #4/1                       6 + 10
+
+ threat:
+          2.Rh5-h8 #
+      1...Ra4-h4
+          2.Rh5*h4 threat:
+                  3.Rh4-h8 #
+              2...f7-f6
+                  3.Rh4-h8 +
+                      3...Ke8-f7
+                          4.Rh8-f8 #
+                  3.Bf5-e6 threat:
+                          4.Rh4-h8 #
+      1...Ra4-e4 +
+          2.Sg3*e4 threat:
+                  3.Rh5-h8 #
+              2...f7-f6
+                  3.Bf5-e6 threat:
+                          4.Rh5-h8 #
+                  3.Rh5-h8 +
+                      3...Ke8-f7
+                          4.Rh8-f8 #
+      1...f7-f6
+          2.Rh5-h8 +
+              2...Ke8-f7
+                  3.Rh8-f8 #
+  add_to_move_generation_stack:       20290
+                     play_move:       16025
+ is_white_king_square_attacked:        8788
+ is_black_king_square_attacked:        8735
+
+solution finished.
+
+
+
+       direct mate with twins
+
++---a---b---c---d---e---f---g---h---+
+|                                   |
+8   .   .   .   .   .   .   .   .   8
+|                                   |
+7   .   .   .   .   .   .   .   .   7
+|                                   |
+6   .   .   .   .   .   .   .   .   6
+|                                   |
+5   .   .   .   .   .   .   .   .   5
+|                                   |
+4   .   .   .   .   .   .   .   .   4
+|                                   |
+3   .   R   .   .   .   .   .   .   3
+|                                   |
+2  -P   .   .   .   .   .   .   .   2
+|                                   |
+1  -K   .   K   .   .   .   .   Q   1
+|                                   |
++---a---b---c---d---e---f---g---h---+
+  #3                          3 + 2
+
+a) 
+
+   1.Kc1-d2 # !
+
+   1.Kc1-c2 # !
+
+   1.Qh1-h8 # !
+
+  add_to_move_generation_stack:         283
+                     play_move:         309
+ is_white_king_square_attacked:         159
+ is_black_king_square_attacked:         195
+
+b) wRb3-->b4  
+
+   1.Kc1-d2 # !
+
+   1.Kc1-c2 # !
+
+   1.Qh1-h8 # !
+
+  add_to_move_generation_stack:         283
+                     play_move:         309
+ is_white_king_square_attacked:         159
+ is_black_king_square_attacked:         195
+
+solution finished.
+
+
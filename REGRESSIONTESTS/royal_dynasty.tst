@@ -0,0 +1,66 @@
+the royal flag is moved between pieces without changing their walks
+
+a king is added by promotion, castling
+
++---a---b---c---d---e---f---g---h---+
+|                                   |
+8   .   .   .   .   .   .   .   .   8
+|                                   |
+7   P   .   .   .   .   .   .   .   7
+|                                   |
+6   .   .   .   .   .   .   .   .   6
+|                                   |
+5   .   .   .   .   .   .   .   .   5
+|                                   |
+4   .   .   .   .   .   .   .   .   4
+|                                   |
+3   .   .   .   .   .   .   .   .   3
+|                                   |
+2   .   .   .   .   .   .   .   .   2
+|                                   |
+1   .   .   .   .   K   .   .   R   1
+|                                   |
++---a---b---c---d---e---f---g---h---+
+  exact-ser-002               3 + 0
+            RoyalDynasty
+
+  1.a7-a8=Q   2.0-0
+  1.a7-a8=S   2.0-0
+  1.a7-a8=R   2.0-0
+  1.a7-a8=B   2.0-0
+
+solution finished.
+
+
+
+          Bernd Schwarzkopf
+the royal flag moves on when a king is captured
+
++---a---b---c---d---e---f---g---h---+
+|                                   |
+8   .   .   .   .   .   .   .   .   8
+|                                   |
+7   .   .   .   .   .   .   .   .   7
+|                                   |
+6   .   .   .   .   .   .   .   .   6
+|                                   |
+5   .   .   .   .   .   .   .   .   5
+|                                   |
+4   .   .   .   R   .   .   .   .   4
+|                                   |
+3   .   .   .   .   .  -P   .  -K   3
+|                                   |
+2   .   .   .   .   .   .   .  -P   2
+|                                   |
+1   .   .   .   .   K   .   .   K   1
+|                                   |
++---a---b---c---d---e---f---g---h---+
+  ser-s#2                     3 + 3
+            RoyalDynasty
+
+  1.Ke1-f2   2.Kf2-g2 + f3*g2 #
+  1.Ke1-f1   2.Kf1-g2 + f3*g2 #
+
+solution finished.
+
+
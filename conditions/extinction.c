@@ -66,23 +66,26 @@ boolean exctinction_all_piece_observation_tester_is_in_check(slice_index si,
                                                              Side side_attacked)
 {
   boolean result = false;
-  square const *bnp;
+  square_set_type squares_attacked = get_squares_occupied_by(side_attacked);
 
   TraceFunctionEntry(__func__);
   TraceFunctionParam("%u",si);
   TraceEnumerator(Side,side_attacked);
   TraceFunctionParamListEnd();
 
-  for (bnp = boardnum; *bnp; ++bnp)
-    if (TSTFLAG(being_solved.spec[*bnp],side_attacked))
+  while (squares_attacked!=0)
+  {
+    square const sq_attacked = square_set_pop_first(&squares_attacked);
+    if (TSTFLAG(being_solved.spec[sq_attacked],side_attacked))
     {
-      replace_observation_target(*bnp);
+      replace_observation_target(sq_attacked);
       if (is_square_observed(EVALUATE(check)))
       {
         result = true;
         break;
       }
     }
+  }
 
   TraceFunctionExit(__func__);
   TraceFunctionResult("%u",result);
@@ -6,6 +6,7 @@
 #include "solving/find_square_observer_tracking_back_from_target.h"
 #include "solving/pipe.h"
 #include "solving/fork.h"
+#include "optimisations/observation_cache.h"
 #include "stipulation/stipulation.h"
 
 #include "debugging/trace.h"
@@ -41,8 +42,15 @@ boolean madrasi_is_moving_piece_observed(square sq)
       nextply(observing_side);
       push_observation_target(sq);
       observing_walk[nbply] = p;
-      result = fork_is_square_observed_nested_delegate(temporary_hack_is_square_observed_specific[trait[nbply]],
-                                                       EVALUATE(observation_geometry));
+      {
+        validator_id const evaluate = EVALUATE(observation_geometry);
+        if (!observation_cache_lookup(p,evaluate,&result))
+        {
+          result = fork_is_square_observed_nested_delegate(temporary_hack_is_square_observed_specific[trait[nbply]],
+                                                           evaluate);
+          observation_cache_remember(p,evaluate,result);
+        }
+      }
       finply();
     }
   }
@@ -78,8 +86,15 @@ boolean madrasi_is_piece_observed_by_walk(square sq_observee,
     siblingply(observing_side);
     push_observation_target(sq_observee);
     observing_walk[nbply] = walk;
-    result = fork_is_square_observed_nested_delegate(temporary_hack_is_square_observed_specific[observed_side],
-                                                     EVALUATE(observation_geometry));
+    {
+      validator_id const evaluate = EVALUATE(observation_geometry);
+      if (!observation_cache_lookup(walk,evaluate,&result))
+      {
+        result = fork_is_square_observed_nested_delegate(temporary_hack_is_square_observed_specific[observed_side],
+                                                         evaluate);
+        observation_cache_remember(walk,evaluate,result);
+      }
+    }
     finply();
   }
   else
@@ -362,7 +362,7 @@ void marscirce_iterate_observers(slice_index si)
 {
   circe_rebirth_context_elmt_type * const context = &circe_rebirth_context_stack[circe_rebirth_context_stack_pointer];
   Side const side_observing = trait[nbply];
-  square const *observer_origin;
+  square_set_type observer_origins = get_squares_occupied_by(side_observing);
   square const sq_target = move_generation_stack[CURRMOVE_OF_PLY(nbply)].capture;
 
   TraceFunctionEntry(__func__);
@@ -373,12 +373,14 @@ void marscirce_iterate_observers(slice_index si)
 
   context->relevant_ply = nbply;
 
-  for (observer_origin = boardnum; *observer_origin; ++observer_origin)
-    if (*observer_origin!=sq_target /* no auto-observation */
-        && TSTFLAG(being_solved.spec[*observer_origin],side_observing)
-        && get_walk_of_piece_on_square(*observer_origin)==observing_walk[nbply])
+  while (observer_origins!=0)
+  {
+    square const observer_origin = square_set_pop_first(&observer_origins);
+    if (observer_origin!=sq_target /* no auto-observation */
+        && TSTFLAG(being_solved.spec[observer_origin],side_observing)
+        && get_walk_of_piece_on_square(observer_origin)==observing_walk[nbply])
     {
-      context->rebirth_from = *observer_origin;
+      context->rebirth_from = observer_origin;
       context->reborn_walk = observing_walk[nbply];
       context->reborn_spec = being_solved.spec[context->rebirth_from];
       context->relevant_side = advers(side_observing);
@@ -389,6 +391,7 @@ void marscirce_iterate_observers(slice_index si)
       if (observation_result)
         break;
     }
+  }
 
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
@@ -146,6 +146,23 @@ static void dump_castling_rights_initialiser_to_stream(FILE *dest, position cons
   fprintf(dest,"  0x%x /* castling_rights */\n",pos->castling_rights);
 }
 
+/* Write initialiser of the sets of squares occupied by the orthodox walks
+ * @param dest destination stream (output file)
+ * @param pos position object containing initial position
+ */
+static void dump_occupied_by_walk_initialiser_to_stream(FILE *dest,
+                                                        position const *pos)
+{
+  piece_walk_type walk;
+
+  fputs("  , { /* occupied_by_walk */\n",dest);
+  for (walk = Empty; walk<=Bishop; ++walk)
+    fprintf(dest,"      %s0x%llxull\n",
+            walk==Empty ? "" : ", ",
+            pos->occupied_by_walk[walk]);
+  fputs("    }\n",dest);
+}
+
 /* Write position initialiser to output file
  * @param dest destination stream (output file)
  * @param pos array of position object containing initial position
@@ -167,6 +184,11 @@ static void dump_position_initialiser_to_stream(FILE *dest, position const *pos)
   fputs(",\n",dest);
   dump_castling_rights_initialiser_to_stream(dest,pos);
   fputs("  , 0 /* currPieceId */\n",dest);
+  fprintf(dest,"  , 0x%llxull /* hash_key */\n",pos->hash_key);
+  fprintf(dest,"  , { 0x%llxull, 0x%llxull } /* occupied */\n",
+          pos->occupied[White],pos->occupied[Black]);
+  fprintf(dest,"  , 0x%llxull /* non_empty */\n",pos->non_empty);
+  dump_occupied_by_walk_initialiser_to_stream(dest,pos);
   fputs("};\n",dest);
 }
 
@@ -5,10 +5,14 @@
 #include "platform/maxtime.h"
 #include "platform/maxmem.h"
 #include "input/plaintext/memory.h"
+#include "options/movenumbers/root_move_splitter.h"
 #include "stipulation/pipe.h"
 #include "solving/pipe.h"
+#include "solving/machinery/profile.h"
+#include "solving/machinery/perft.h"
 #include "debugging/trace.h"
 
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -52,6 +56,60 @@ static int parseCommandlineOptions(int argc, char *argv[])
       idx += 2;
       continue;
     }
+    else if (idx+1<argc && strcmp(argv[idx],"-memorymode")==0)
+    {
+      input_plaintext_read_memory_backing(argv[idx+1]);
+      idx += 2;
+      continue;
+    }
+    else if (idx+1<argc && strcmp(argv[idx],"-threads")==0)
+    {
+      char *end;
+      unsigned long const value = strtoul(argv[idx+1], &end, 10);
+      if (argv[idx+1]==end || value>UINT_MAX)
+        ; /* conversion failure -> solve in a single process */
+      else
+        root_move_splitter_set_nr_workers((unsigned int)value);
+
+      idx += 2;
+      continue;
+    }
+    else if (strcmp(argv[idx], "-hashreplace")==0)
+    {
+      hash_request_bucket_table();
+      idx++;
+      continue;
+    }
+    else if (strcmp(argv[idx], "-hashkeep")==0)
+    {
+      hash_request_keeping_across_twins();
+      idx++;
+      continue;
+    }
+    else if (idx+1<argc && strcmp(argv[idx],"-hashfile")==0)
+    {
+      hash_request_file(argv[idx+1]);
+      idx += 2;
+      continue;
+    }
+    else if (idx+1<argc && strcmp(argv[idx],"-profile")==0)
+    {
+      profile_request(argv[idx+1]);
+      idx += 2;
+      continue;
+    }
+    else if (idx+1<argc && strcmp(argv[idx],"-perft")==0)
+    {
+      char *end;
+      unsigned long const value = strtoul(argv[idx+1], &end, 10);
+      if (argv[idx+1]==end || value>UINT_MAX)
+        ; /* conversion failure -> solve as usual */
+      else
+        perft_request((unsigned int)value);
+
+      idx += 2;
+      continue;
+    }
     else if (strcmp(argv[idx], "-regression")==0)
     {
       protocol_overwrite();
@@ -108,6 +166,8 @@ void command_line_options_parser_solve(slice_index si)
   slice_insertion_insert(si,&opener,1);
 
   pipe_solve_delegate(si);
+
+  profile_close();
 }
 
 slice_index alloc_command_line_options_parser(int argc, char **argv)
@@ -4,6 +4,7 @@
 #include "output/output.h"
 #include "output/plaintext/language_dependant.h"
 #include "output/plaintext/message.h"
+#include "optimisations/hash.h"
 #include "pieces/pieces.h"
 #include "pieces/walks/pawns/promotee_sequence.h"
 #include "pieces/attributes/chameleon.h"
@@ -1769,6 +1770,9 @@ void InitCond(void)
   square const *bnp;
   square i, j;
 
+  /* the positions stored may depend on the parameters of the conditions */
+  hash_discard_kept_table();
+
   mummer_strictness[White] = mummer_strictness_none;
   mummer_strictness[Black] = mummer_strictness_none;
 
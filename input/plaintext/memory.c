@@ -2,6 +2,7 @@
 #include "platform/maxmem.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 /* Interpret maxmem command line parameter value
  * @param commandLineValue value of -maxmem command line parameter
@@ -21,3 +22,45 @@ void input_plaintext_read_requested_memory(char const *commandLineValue)
 
   platform_request_memory(requested);
 }
+
+/* Interpret memorymode command line parameter value
+ * @param commandLineValue value of -memorymode command line parameter, a comma
+ *                         separated list of huge, interleave, bind and
+ *                         prefault
+ */
+void input_plaintext_read_memory_backing(char const *commandLineValue)
+{
+  static struct
+  {
+      char const *name;
+      unsigned int backing;
+  } const modes[] =
+  {
+      { "huge", memory_backing_huge_pages },
+      { "interleave", memory_backing_numa_interleave },
+      { "bind", memory_backing_numa_bind },
+      { "prefault", memory_backing_prefault }
+  };
+  enum { nr_modes = sizeof modes / sizeof modes[0] };
+
+  unsigned int backing = 0;
+  char const *word = commandLineValue;
+
+  while (*word!='\0')
+  {
+    size_t const length = strcspn(word,",");
+    unsigned int i;
+
+    for (i = 0; i!=nr_modes; ++i)
+      if (strlen(modes[i].name)==length
+          && strncmp(word,modes[i].name,length)==0)
+        backing |= modes[i].backing;
+    /* unknown modes are ignored */
+
+    word += length;
+    if (*word==',')
+      ++word;
+  }
+
+  platform_request_memory_backing(backing);
+}
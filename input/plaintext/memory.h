@@ -6,4 +6,11 @@
  */
 void input_plaintext_read_requested_memory(char const *commandLineValue);
 
+/* Interpret memorymode command line parameter value
+ * @param commandLineValue value of -memorymode command line parameter, a comma
+ *                         separated list of huge, interleave, bind and
+ *                         prefault
+ */
+void input_plaintext_read_memory_backing(char const *commandLineValue);
+
 #endif
@@ -32,6 +32,8 @@
 #include "stipulation/modifier.h"
 #include "solving/goals/prerequisite_guards.h"
 #include "solving/machinery/twin.h"
+#include "solving/machinery/profile.h"
+#include "solving/machinery/perft.h"
 #include "solving/pipe.h"
 #include "solving/duplex.h"
 #include "solving/proofgames.h"
@@ -793,12 +795,25 @@ void solving_machinery_intro_builder_solve(slice_index si)
         alloc_pipe(STSolversBuilder2),
         alloc_pipe(STSlackLengthAdjuster),
         alloc_pipe(STProxyResolver),
+        alloc_pipe(STFilterFuser),
         alloc_illegal_selfcheck_writer_slice()
     };
     enum { nr_prototypes = sizeof prototypes / sizeof prototypes[0] };
     slice_insertion_insert(si,prototypes,nr_prototypes);
   }
 
+  if (is_profiling)
+  {
+    slice_index const prototype = alloc_pipe(STProfileWriter);
+    slice_insertion_insert(si,&prototype,1);
+  }
+
+  if (perft_depth>0)
+  {
+    slice_index const prototype = alloc_pipe(STPerftWriter);
+    slice_insertion_insert(si,&prototype,1);
+  }
+
   solving_impose_starter(si,SLICE_STARTER(si));
 
   pipe_solve_delegate(si);
@@ -816,7 +831,9 @@ void stipulation_copier_solve(slice_index si)
   TraceFunctionParamListEnd();
 
   {
-    slice_index const proto = stip_deep_copy(SLICE_NEXT1(stipulation_prototype));
+    slice_index const proto = (perft_depth>0
+                               ? alloc_perft_stipulation()
+                               : stip_deep_copy(SLICE_NEXT1(stipulation_prototype)));
     slice_insertion_insert(si,&proto,1);
   }
 
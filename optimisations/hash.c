@@ -36,6 +36,12 @@
  ** coded after the eight bytes. Both functions give for each piece its
  ** type (1 byte) and specification (2 bytes). After this information
  ** about en_passant_multistep_over[0]-captures, Duellants and Imitators are coded.
+ ** Each encoding is preceded by the lower bytes of a 64 bit key of the
+ ** position. The key is composed of the key of the board maintained by the
+ ** position functions while moves are played and retracted, and a checksum
+ ** of the encoding of the rest of the position. The hash table is indexed
+ ** using the key, the encoding serves for verifying that the right position
+ ** has been found.
  **
  ** The hash table uses a dynamic hashing scheme which allows dynamic
  ** growth and shrinkage of the hashtable. See the relevant dht* files
@@ -83,11 +89,14 @@
 #include <limits.h>
 
 #include <memory.h>
+#include <string.h>
 #include "optimisations/hash.h"
 #include "output/plaintext/message.h"
 #include "solving/proofgames.h"
 #include "DHT/dhtvalue.h"
 #include "DHT/dht.h"
+#include "optimisations/lockless_hash.h"
+#include "options/movenumbers/root_move_splitter.h"
 #include "pieces/walks/pawns/en_passant.h"
 #include "conditions/bgl.h"
 #include "conditions/circe/circe.h"
@@ -96,6 +105,13 @@
 #include "conditions/haunted_chess.h"
 #include "conditions/imitator.h"
 #include "options/nontrivial.h"
+#include "options/maxflightsquares.h"
+#include "options/maxthreatlength.h"
+#include "output/plaintext/condition.h"
+#include "pieces/attributes/chameleon.h"
+#include "pieces/walks/hunters.h"
+#include "pieces/walks/walks.h"
+#include "solving/battle_play/try.h"
 #include "solving/avoid_unsolvable.h"
 #include "solving/castling.h"
 #include "solving/machinery/slack_length.h"
@@ -107,7 +123,10 @@
 #include "stipulation/pipe.h"
 #include "platform/maxtime.h"
 #include "platform/maxmem.h"
+#include "options/maxsolutions/maxsolutions.h"
+#include "stipulation/structure_traversal.h"
 #include "solving/pipe.h"
+#include "solving/machinery/profile.h"
 #include "debugging/trace.h"
 #include "pieces/pieces.h"
 #include "pieces/attributes/neutral/neutral.h"
@@ -124,9 +143,43 @@ typedef unsigned int hash_value_type;
 
 static struct dht *pyhash;
 
+/* Positions are stored in a table of fixed size buckets (see
+ * optimisations/lockless_hash.h) rather than in pyhash if the user has asked
+ * for it or while the root moves are distributed over worker processes; the
+ * processes share that table.
+ */
+static boolean is_bucket_table_requested;
+static boolean is_bucket_table_used;
+
+/* prefix of the names of the files holding the bucket table; 0 if the
+ * bucket table is held in memory only */
+static char const *hash_file_prefix;
+static boolean is_hash_file_used;
+
+/* false if the table is opened for each target position of intelligent mode;
+ * the positions stored are then only valid for the target position */
+static boolean is_table_reusable;
+
+/* keep the table from one twin to the next if its positions remain valid */
+static boolean is_keeping_requested;
+static boolean is_table_kept;
+
+/* fingerprint of what the positions in the current table are valid for */
+static lockless_hash_fingerprint_type table_fingerprint;
+
+/* fingerprint of the stipulation being solved with the current table */
+static lockless_hash_fingerprint_type stipulation_fingerprint;
+
 static char    piece_nbr[nr_piece_walks];
 static boolean one_byte_hash;
 static unsigned int bytes_per_spec;
+
+/* the key of the board doesn't tell apart pieces with different ids */
+static boolean are_piece_ids_encoded;
+
+/* encode function used with pyhash */
+static void (*encode_dht)(stip_length_type min_length,
+                          stip_length_type validity_value);
 static unsigned int bytes_per_piece;
 
 /* TODO we should remove help hash slices instead of testing this flag over and
@@ -149,6 +202,35 @@ static slice_index hash_slices[max_nr_slices];
 
 HashBuffer hashBuffers[maxply+1];
 
+/* keys of the positions encoded in hashBuffers */
+static lockless_hash_key_type hash_keys[maxply+1];
+
+enum
+{
+  /* number of bytes of the key preceding the encoding */
+  key_prefix_length = 4
+};
+
+/* Determine the hash value of an encoded position, i.e. the key written in
+ * front of the encoding
+ * @param v address of the HashBuffer
+ * @return hash value
+ */
+static dhtHashValue ConvertHashBuffer(dhtConstValue v)
+{
+  BCMemValue const * const value = v;
+  dhtHashValue result = 0;
+  unsigned int i;
+
+  for (i = 0; i!=key_prefix_length; ++i)
+    result = (result<<CHAR_BIT) | value->Data[i];
+
+  return result;
+}
+
+/* procedures of dhtBCMemValue except for the hash function */
+static dhtValueProcedures hashBufferProcs;
+
 #if defined(TESTHASH)
 static void dump_hash_buffer(void)
 {
@@ -994,9 +1076,6 @@ static void compresshash (void)
   fprintf(stdout," / %lu", use_all);
   fprintf(stdout," = %.1f%%", (100.0 * use_pos) / use_all);
 #endif
-#if defined(FREEMAP) && defined(FXF)
-  PrintFreeMap(stdout);
-#endif /*FREEMAP*/
   fputs("\n",stdout);
 #if defined(FXF)
   fputs("\n after compression:\n",stdout);
@@ -1018,11 +1097,18 @@ static void compresshash (void)
  */
 static unsigned int HashRateLevel = 0;
 
+static void print_number(message_id_t id, unsigned long number)
+{
+  char buffer[3*sizeof number+1];
+  sprintf(buffer,"%lu",number);
+  output_plaintext_message(id,buffer);
+}
+
 void IncHashRateLevel(void)
 {
   ++HashRateLevel;
   output_plaintext_print_time("  ","");
-  Message(IncrementHashRateLevel,HashRateLevel);
+  print_number(IncrementHashRateLevel,HashRateLevel);
   HashStats(0, "\n");
 }
 
@@ -1031,7 +1117,7 @@ void DecHashRateLevel(void)
   if (HashRateLevel>0)
     --HashRateLevel;
   output_plaintext_print_time("  ","");
-  Message(DecrementHashRateLevel,HashRateLevel);
+  print_number(DecrementHashRateLevel,HashRateLevel);
   HashStats(0, "\n");
 }
 
@@ -1052,34 +1138,48 @@ void DecHashRateLevel(void)
 void HashStats(unsigned int level, char *trailer)
 {
 #if defined(HASHRATE)
-  int pos=dhtKeyCount(pyhash);
-
   if (level<=HashRateLevel)
   {
+    unsigned long nr_lookups = use_all;
+
     fputs("  ",stdout);
-    pos= dhtKeyCount(pyhash);
-    Message2(stdout,HashedPositions,pos);
-    if (use_all > 0)
+    if (is_bucket_table_used)
     {
-      if (use_all < 10000)
-        fprintf(stdout,), " %ld/%ld = %ld%%",
-                use_pos, use_all, (use_pos*100) / use_all);
-      else
-        fprintf(stdout,, " %ld/%ld = %ld%%",
-                use_pos, use_all, use_pos / (use_all/100));
+      lockless_hash_statistics_type statistics;
+      lockless_hash_get_statistics(&statistics);
+      nr_lookups = statistics.nr_lookups;
+      fprintf(stdout,"%lu hits/%lu lookups",
+              statistics.nr_hits,statistics.nr_lookups);
+      fprintf(stdout,", %lu replaced/%lu stored (%lu stale)",
+              statistics.nr_replacements,statistics.nr_stores,
+              statistics.nr_stale_replacements);
+      fprintf(stdout,", generation %u",statistics.generation);
     }
     else
-      fputs(" -",stdout);
+    {
+      print_number(HashedPositions,dhtKeyCount(pyhash));
+      if (use_all > 0)
+      {
+        if (use_all < 10000)
+          fprintf(stdout, " %ld/%ld = %ld%%",
+                  use_pos, use_all, (use_pos*100) / use_all);
+        else
+          fprintf(stdout, " %ld/%ld = %ld%%",
+                  use_pos, use_all, use_pos / (use_all/100));
+      }
+      else
+        fputs(" -",stdout);
+    }
     if (HashRateLevel > 3)
     {
       unsigned long msec;
       unsigned long Seconds;
       StopTimer(&Seconds,&msec);
       if (Seconds > 0)
-        fprintf(stdout, ", %lu pos/s", use_all/Seconds);
+        fprintf(stdout, ", %lu pos/s", nr_lookups/Seconds);
     }
     if (trailer)
-      StdString2(stdout,trailer);
+      fputs(trailer,stdout);
   }
 #endif /*HASHRATE*/
 }
@@ -1118,6 +1218,53 @@ static unsigned int estimateNumberOfHoles(void)
   return result;
 }
 
+/* Complete the encoding of the current position: determine its key and write
+ * the key in front of the encoding
+ * @param hb address of the hash buffer
+ * @param tail address of the part of the encoding that doesn't represent the
+ *             board
+ * @param end address behind the encoding
+ */
+static void finish_encoding(HashBuffer *hb, byte const *tail, byte const *end)
+{
+  lockless_hash_key_type key;
+
+#if defined(TESTHASH)
+  {
+    position_hash_key_type const incremental = being_solved.hash_key;
+    calculate_position_hash_key(&being_solved);
+    assert(being_solved.hash_key==incremental);
+  }
+#endif
+
+  if (is_bucket_table_used && are_piece_ids_encoded)
+  {
+    /* the bucket table doesn't verify positions using their encodings */
+    byte const * const begin = hb->cmv.Data+key_prefix_length;
+    key = lockless_hash_key(begin,(unsigned int)(end-begin));
+  }
+  else
+  {
+    key = being_solved.hash_key ^ lockless_hash_key(tail,(unsigned int)(end-tail));
+    if (key==0)
+      key = 1;
+  }
+
+  hash_keys[nbply] = key;
+
+  {
+    byte *bp = hb->cmv.Data+key_prefix_length;
+    do
+    {
+      *--bp = (byte)(key & ByteMask);
+      key >>= CHAR_BIT;
+    } while (bp!=hb->cmv.Data);
+  }
+
+  assert(end-hb->cmv.Data<=UCHAR_MAX);
+  hb->cmv.Leng = (unsigned char)(end-hb->cmv.Data);
+}
+
 static void ProofSmallEncodePiece(byte **bp,
                                   int row, int col,
                                   piece_walk_type p, Flags flags,
@@ -1153,8 +1300,9 @@ static void ProofLargeEncodePiece(byte **bp,
 static void ProofEncode(stip_length_type min_length, stip_length_type validity_value)
 {
   HashBuffer *hb = &hashBuffers[nbply];
-  byte *position = hb->cmv.Data;
+  byte *position = hb->cmv.Data+key_prefix_length;
   byte *bp = position+nr_rows_on_board;
+  byte const *tail;
 
   /* clear the bits for storing the position of pieces */
   memset(position, 0, nr_rows_on_board);
@@ -1186,6 +1334,8 @@ static void ProofEncode(stip_length_type min_length, stip_length_type validity_v
       ++bp;
   }
 
+  tail = bp;
+
   {
     underworld_index_type gi;
     for (gi = 0; gi<nr_ghosts; ++gi)
@@ -1204,13 +1354,13 @@ static void ProofEncode(stip_length_type min_length, stip_length_type validity_v
   /* Now the rest of the party */
   bp = CommonEncode(bp,min_length,validity_value);
 
-  assert(bp-hb->cmv.Data<=UCHAR_MAX);
-  hb->cmv.Leng = (unsigned char)(bp-hb->cmv.Data);
+  finish_encoding(hb,tail,bp);
 }
 
 static unsigned int TellCommonEncodePosLeng(unsigned int len,
                                             unsigned int nbr_p)
 {
+  len += key_prefix_length;
   len += 2; /* Castling_Flag, validity_value */
 
   if (CondFlag[haanerchess])
@@ -1467,8 +1617,9 @@ static void LargeEncode(stip_length_type min_length,
                         stip_length_type validity_value)
 {
   HashBuffer *hb = &hashBuffers[nbply];
-  byte *position = hb->cmv.Data;
+  byte *position = hb->cmv.Data+key_prefix_length;
   byte *bp = position+nr_rows_on_board;
+  byte const *tail;
   int row, col;
   square a_square = square_a1;
   underworld_index_type gi;
@@ -1490,6 +1641,8 @@ static void LargeEncode(stip_length_type min_length,
     }
   }
 
+  tail = bp;
+
   for (gi = 0; gi<nr_ghosts; ++gi)
   {
     square s = (underworld[gi].on
@@ -1505,8 +1658,7 @@ static void LargeEncode(stip_length_type min_length,
   /* Now the rest of the party */
   bp = CommonEncode(bp,min_length,validity_value);
 
-  assert(bp-hb->cmv.Data<=UCHAR_MAX);
-  hb->cmv.Leng = (unsigned char)(bp-hb->cmv.Data);
+  finish_encoding(hb,tail,bp);
 
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
@@ -1534,7 +1686,8 @@ static void SmallEncode(stip_length_type min_length,
                         stip_length_type validity_value)
 {
   HashBuffer *hb = &hashBuffers[nbply];
-  byte *bp = hb->cmv.Data;
+  byte *bp = hb->cmv.Data+key_prefix_length;
+  byte const *tail;
   square a_square = square_a1;
   int row;
   int col;
@@ -1554,6 +1707,8 @@ static void SmallEncode(stip_length_type min_length,
     }
   }
 
+  tail = bp;
+
   for (gi = 0; gi<nr_ghosts; ++gi)
   {
     square s = (underworld[gi].on
@@ -1569,8 +1724,39 @@ static void SmallEncode(stip_length_type min_length,
   /* Now the rest of the party */
   bp = CommonEncode(bp,min_length,validity_value);
 
-  assert(bp-hb->cmv.Data<=UCHAR_MAX);
-  hb->cmv.Leng = (unsigned char)(bp-hb->cmv.Data);
+  finish_encoding(hb,tail,bp);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Encode the current position for the bucket table if the encoding of the board can be represented by the key of the board,
+ * i.e. if the encoding doesn't contain piece ids
+ */
+static void KeyEncode(stip_length_type min_length,
+                      stip_length_type validity_value)
+{
+  HashBuffer *hb = &hashBuffers[nbply];
+  byte *bp = hb->cmv.Data+key_prefix_length;
+  byte const * const tail = bp;
+  underworld_index_type gi;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  for (gi = 0; gi<nr_ghosts; ++gi)
+  {
+    square s = (underworld[gi].on
+                - nr_of_slack_rows_below_board*onerow
+                - nr_of_slack_files_left_of_board);
+    bp = SmallEncodePiece(bp,
+                          s/onerow,s%onerow,
+                          underworld[gi].walk,underworld[gi].flags);
+  }
+
+  bp = CommonEncode(bp,min_length,validity_value);
+
+  finish_encoding(hb,tail,bp);
 
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
@@ -1634,7 +1820,7 @@ static dhtElement *allocDHTelement(dhtConstValue hb)
 #if defined(FXF)
       fxfReset();
 #endif
-      pyhash = dhtCreate(dhtBCMemValue,dhtCopy,dhtSimpleValue,dhtNoCopy);
+      pyhash = dhtCreate(dhtUser1Value,dhtCopy,dhtSimpleValue,dhtNoCopy);
       assert(pyhash!=0);
       result = dhtEnterElement(pyhash,hb,template_element.d.Data);
       break;
@@ -1654,8 +1840,362 @@ static dhtElement *allocDHTelement(dhtConstValue hb)
   return result;
 }
 
+/* Find the hash table element of the position encoded in hashBuffers[nbply]
+ * @param copy where to copy the element to if the bucket table is used
+ * @return address of the element (copy if the bucket table is used);
+ *         0 if the position isn't in the table
+ */
+static hashElement_union_t *find_element(hashElement_union_t *copy)
+{
+  HashBuffer const * const hb = &hashBuffers[nbply];
+  hashElement_union_t *result;
+
+  if (is_bucket_table_used)
+    result = lockless_hash_lookup(hash_keys[nbply],&copy->e.data) ? copy : 0;
+  else
+  {
+    dhtElement * const he = dhtLookupElement(pyhash,hb);
+    result = he==dhtNilElement ? 0 : (hashElement_union_t *)he;
+  }
+
+  PROFILE_COUNT(profile_hash_probes);
+  if (result!=0)
+    PROFILE_COUNT(profile_hash_hits);
+
+  return result;
+}
+
+/* Enter the position encoded in hashBuffers[nbply] into the hash table
+ * @param copy where to create the element if the bucket table is used
+ * @return address of the new element (copy if the bucket table is used)
+ * @note the caller has to invoke element_modified() once the element has been
+ *       assigned its value
+ */
+static hashElement_union_t *enter_element(hashElement_union_t *copy)
+{
+  if (is_bucket_table_used)
+  {
+    copy->e.data = template_element.e.data;
+    return copy;
+  }
+  else
+    return (hashElement_union_t *)allocDHTelement(&hashBuffers[nbply]);
+}
+
+/* Write back a hash table element after it has been modified
+ * @param hue address of the element as returned by find_element() or
+ *            enter_element()
+ */
+static void element_modified(hashElement_union_t const *hue)
+{
+  if (is_bucket_table_used)
+  {
+    /* once solving has been interrupted, positions are stored with values
+     * that don't hold; they mustn't survive in the file */
+    if (is_hash_file_used
+        && (platform_has_maxtime_elapsed() || max_nr_solutions_found_in_phase()))
+      return;
+
+    lockless_hash_store(hash_keys[nbply],hue->e.data,value_of_data(hue));
+  }
+}
+
 static unsigned long hashtable_kilos;
 
+/* part of hashtable_kilos lent to another table of the solving machinery */
+static unsigned long lent_kilos;
+
+#if defined(FXF)
+/* size of the arena; hashtable_kilos-lent_kilos if the arena holds the
+ * positions */
+static unsigned long arena_kilos;
+static boolean is_arena_holding_positions;
+#endif
+
+/* An entry of the bucket table takes 16 bytes, while a position in the DHT
+ * takes its encoding, a DHT element and a share of the DHT's directory, i.e.
+ * 50 bytes or more. If the bucket table is requested, it is therefore given
+ * all the memory for the positions; the arena of the DHT is kept this small.
+ */
+enum
+{
+  bucket_table_arena_kilos = 64
+};
+
+/* Store positions in a table of fixed size buckets where a new position
+ * replaces a less valuable one, rather than in a table that has to be
+ * compressed when it is full
+ */
+void hash_request_bucket_table(void)
+{
+  is_bucket_table_requested = true;
+}
+
+/* Hold the bucket table in a file that survives the process, and take over
+ * the table from the file when the same problem is solved again.
+ * The name of the file consists of a prefix and a fingerprint of the problem
+ * and the twin.
+ * @param prefix prefix of the file name
+ */
+void hash_request_file(char const *prefix)
+{
+  is_bucket_table_requested = true;
+  hash_file_prefix = prefix;
+}
+
+/* Keep the hash table from one twin to the next as long as the positions
+ * stored remain valid, i.e. unless the stipulation or the conditions change
+ */
+void hash_request_keeping_across_twins(void)
+{
+  is_keeping_requested = true;
+}
+
+/* Add data to a fingerprint
+ * @param fingerprint fingerprint so far
+ * @param data address of the data
+ * @param length number of bytes of the data
+ * @return fingerprint including the data
+ */
+static lockless_hash_fingerprint_type fingerprint_add(lockless_hash_fingerprint_type fingerprint,
+                                                      void const *data,
+                                                      size_t length)
+{
+  /* FNV-1a */
+  unsigned char const * const bytes = data;
+  size_t i;
+
+  for (i = 0; i!=length; ++i)
+  {
+    fingerprint ^= bytes[i];
+    fingerprint *= 1099511628211ull;
+  }
+
+  return fingerprint;
+}
+
+static void fingerprint_slice(slice_index si, stip_structure_traversal *st)
+{
+  lockless_hash_fingerprint_type * const fingerprint = st->param;
+  slice_type const type = SLICE_TYPE(si);
+
+  switch (type)
+  {
+    case STMaxTimeProblemInstrumenter:
+    case STMaxTimeSetter:
+    case STMaxTimeGuard:
+    case STMaxSolutionsProblemInstrumenter:
+    case STMaxSolutionsSolvingInstrumenter:
+    case STMaxSolutionsInitialiser:
+    case STMaxSolutionsGuard:
+    case STMaxSolutionsCounter:
+      /* these only limit solving; cf. problem_fingerprint() */
+      stip_traverse_structure_children(si,st);
+      return;
+
+    default:
+      break;
+  }
+
+  *fingerprint = fingerprint_add(*fingerprint,&type,sizeof type);
+  *fingerprint = fingerprint_add(*fingerprint,
+                                 &SLICE_STARTER(si),
+                                 sizeof SLICE_STARTER(si));
+
+  if (slice_type_get_structural_type(type)==slice_structure_branch)
+  {
+    *fingerprint = fingerprint_add(*fingerprint,
+                                   &SLICE_U(si).branch.length,
+                                   sizeof SLICE_U(si).branch.length);
+    *fingerprint = fingerprint_add(*fingerprint,
+                                   &SLICE_U(si).branch.min_length,
+                                   sizeof SLICE_U(si).branch.min_length);
+  }
+  else if (type==STGoalReachedTester)
+  {
+    *fingerprint = fingerprint_add(*fingerprint,
+                                   &SLICE_U(si).goal_handler.goal.type,
+                                   sizeof SLICE_U(si).goal_handler.goal.type);
+    *fingerprint = fingerprint_add(*fingerprint,
+                                   &SLICE_U(si).goal_handler.goal.target,
+                                   sizeof SLICE_U(si).goal_handler.goal.target);
+  }
+
+  stip_traverse_structure_children(si,st);
+}
+
+/* Compute the fingerprint of the stipulation, which determines the meaning
+ * of the data stored for the positions
+ * @param si identifies the root slice of the stipulation
+ */
+static void init_stipulation_fingerprint(slice_index si)
+{
+  stip_structure_traversal st;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  stipulation_fingerprint = 14695981039346656037ull;
+
+  stip_structure_traversal_init(&st,&stipulation_fingerprint);
+  stip_structure_traversal_override_by_structure(&st,
+                                                 slice_structure_pipe,
+                                                 &fingerprint_slice);
+  stip_structure_traversal_override_by_structure(&st,
+                                                 slice_structure_leaf,
+                                                 &fingerprint_slice);
+  stip_structure_traversal_override_by_structure(&st,
+                                                 slice_structure_branch,
+                                                 &fingerprint_slice);
+  stip_structure_traversal_override_by_structure(&st,
+                                                 slice_structure_fork,
+                                                 &fingerprint_slice);
+  stip_traverse_structure(si,&st);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Add a position to a fingerprint
+ * @param fingerprint fingerprint so far
+ * @param pos the position
+ * @return fingerprint including the position
+ */
+static lockless_hash_fingerprint_type fingerprint_add_position(lockless_hash_fingerprint_type fingerprint,
+                                                               position const *pos)
+{
+  fingerprint = fingerprint_add(fingerprint,&pos->hash_key,sizeof pos->hash_key);
+  fingerprint = fingerprint_add(fingerprint,
+                                &pos->castling_rights,
+                                sizeof pos->castling_rights);
+  fingerprint = fingerprint_add(fingerprint,
+                                pos->isquare,
+                                pos->number_of_imitators*sizeof pos->isquare[0]);
+  return fingerprint;
+}
+
+/* fingerprint that fingerprint_condition() adds to */
+static lockless_hash_fingerprint_type conditions_fingerprint;
+
+/* Add the textual representation of a condition, including its parameters
+ * (e.g. circe variant, chameleon sequence), to conditions_fingerprint
+ */
+static void fingerprint_condition(FILE *file,
+                                  char const CondLine[],
+                                  condition_rank rank)
+{
+  conditions_fingerprint = fingerprint_add(conditions_fingerprint,
+                                           CondLine,
+                                           strlen(CondLine)+1);
+}
+
+/* Compute the fingerprint of what the positions stored in the table are valid
+ * for, i.e. of everything that determines the encoding of the positions and
+ * the meaning of the data stored for them
+ * @return fingerprint
+ */
+static lockless_hash_fingerprint_type compute_table_fingerprint(void)
+{
+  lockless_hash_fingerprint_type result = stipulation_fingerprint;
+  unsigned char const encoding = (encode==&ProofEncode ? 0
+                                  : encode==&SmallEncode ? 1
+                                  : 2);
+
+  result = fingerprint_add(result,CondFlag,sizeof CondFlag);
+  result = fingerprint_add(result,ExtraCondFlag,sizeof ExtraCondFlag);
+
+  conditions_fingerprint = result;
+  WriteConditions(0,&fingerprint_condition);
+  result = conditions_fingerprint;
+
+  /* grid, magic squares, wormholes etc. */
+  result = fingerprint_add(result,zzzan,sizeof zzzan);
+
+  /* fairy pieces defined by the problem or the conditions */
+  result = fingerprint_add(result,huntertypes,sizeof huntertypes);
+  result = fingerprint_add(result,chameleon_walk_sequence,sizeof chameleon_walk_sequence);
+  result = fingerprint_add(result,standard_walks,sizeof standard_walks);
+
+  {
+    /* values of the options that restrict what counts as a solution */
+    unsigned int const max_flights = get_max_flights();
+    stip_length_type const max_threat_length = get_max_threat_length();
+    stip_length_type const min_length_nontrivial = get_min_length_nontrivial();
+    unsigned int const max_nr_refutations = get_max_nr_refutations();
+    result = fingerprint_add(result,&max_flights,sizeof max_flights);
+    result = fingerprint_add(result,&max_threat_length,sizeof max_threat_length);
+    result = fingerprint_add(result,&max_nr_nontrivial,sizeof max_nr_nontrivial);
+    result = fingerprint_add(result,&min_length_nontrivial,sizeof min_length_nontrivial);
+    result = fingerprint_add(result,&max_nr_refutations,sizeof max_nr_refutations);
+  }
+
+  {
+    /* options that only limit solving or affect the output don't change the
+     * meaning of the positions stored; in particular, a run with a higher
+     * maxtime can take over the positions of a run that was interrupted */
+    boolean options[OptCount];
+    memcpy(options,OptFlag,sizeof options);
+    options[maxtime] = false;
+    options[maxsols] = false;
+    options[beep] = false;
+    options[noboard] = false;
+    options[suppressgrid] = false;
+    options[writegrid] = false;
+    result = fingerprint_add(result,options,sizeof options);
+  }
+  result = fingerprint_add(result,&some_pieces_flags,sizeof some_pieces_flags);
+  result = fingerprint_add(result,piece_walk_may_exist,sizeof piece_walk_may_exist);
+  result = fingerprint_add(result,&one_byte_hash,sizeof one_byte_hash);
+  result = fingerprint_add(result,&are_piece_ids_encoded,sizeof are_piece_ids_encoded);
+  result = fingerprint_add(result,&encoding,sizeof encoding);
+
+  if (encode==&ProofEncode)
+  {
+    /* what is stored is the distance to the target position */
+    result = fingerprint_add_position(result,&proofgames_start_position);
+    result = fingerprint_add_position(result,&proofgames_target_position);
+  }
+
+  return result;
+}
+
+/* Compute the fingerprint of the problem and twin being solved
+ * @return fingerprint
+ */
+static lockless_hash_fingerprint_type problem_fingerprint(void)
+{
+  lockless_hash_fingerprint_type result = table_fingerprint;
+
+  result = fingerprint_add_position(result,&being_solved);
+  result = fingerprint_add(result,&nr_ghosts,sizeof nr_ghosts);
+  result = fingerprint_add(result,
+                           en_passant_retro_squares,
+                           en_passant_nr_retro_squares*sizeof en_passant_retro_squares[0]);
+
+  return result;
+}
+
+/* Allocate the bucket table in the file of the problem and twin being solved
+ * @return true iff the file could be used
+ */
+static boolean allocate_bucket_table_in_file(void)
+{
+  lockless_hash_fingerprint_type const fingerprint = problem_fingerprint();
+  size_t const length = strlen(hash_file_prefix)+sizeof "-0123456789abcdef.hash";
+  char * const path = malloc(length);
+  boolean result = false;
+
+  if (path!=0)
+  {
+    snprintf(path,length,"%s-%016llx.hash",hash_file_prefix,fingerprint);
+    result = lockless_hash_allocate_in_file(path,fingerprint,hashtable_kilos-lent_kilos)>0;
+    free(path);
+  }
+
+  return result;
+}
+
 /* Allocate memory for the hash table. If the requested amount of
  * memory isn't available, reduce the amount until allocation
  * succeeds.
@@ -1666,9 +2206,23 @@ unsigned long allochash(unsigned long nr_kilos)
 {
 #if defined(FXF)
   size_t const one_kilo = 1<<10;
-  while (fxfInit(nr_kilos*one_kilo)==-1)
-    /* we didn't get hashmemory ... */
-    nr_kilos /= 2;
+  if (is_bucket_table_requested && nr_kilos>bucket_table_arena_kilos)
+  {
+    /* the positions are stored in the bucket table, which gets the memory;
+     * the arena only has to hold the empty DHT */
+    arena_kilos = bucket_table_arena_kilos;
+    while (fxfInit(arena_kilos*one_kilo)==-1 && arena_kilos>0)
+      arena_kilos /= 2;
+    is_arena_holding_positions = false;
+  }
+  else
+  {
+    while (fxfInit(nr_kilos*one_kilo)==-1)
+      /* we didn't get hashmemory ... */
+      nr_kilos /= 2;
+    arena_kilos = nr_kilos;
+    is_arena_holding_positions = true;
+  }
   ifTESTHASH(fxfInfo(stdout));
 #endif /*FXF*/
 
@@ -1676,6 +2230,38 @@ unsigned long allochash(unsigned long nr_kilos)
   return nr_kilos;
 }
 
+/* Lend part of the memory of the hash table to another table of the solving
+ * machinery (e.g. the node table of option ProofNumbers) while the current
+ * twin is solved. The hash table is then created with the rest of the memory.
+ * To be invoked before the hash table is opened.
+ * @param nr_kilos number of kilo-bytes wanted; 0 to take the memory back
+ * @return number of kilo-bytes lent; at most half of the memory
+ */
+unsigned long hash_lend_memory(unsigned long nr_kilos)
+{
+  lent_kilos = nr_kilos<hashtable_kilos/2 ? nr_kilos : hashtable_kilos/2;
+  return lent_kilos;
+}
+
+/* Reset the arena before a new table is created; if memory has been lent
+ * or taken back since the arena was allocated, allocate it with the
+ * memory now available
+ */
+static void reset_arena(void)
+{
+#if defined(FXF)
+  if (is_arena_holding_positions && arena_kilos!=hashtable_kilos-lent_kilos)
+  {
+    size_t const one_kilo = 1<<10;
+    arena_kilos = hashtable_kilos-lent_kilos;
+    while (fxfInit(arena_kilos*one_kilo)==-1 && arena_kilos>0)
+      arena_kilos /= 2;
+  }
+  else
+    fxfReset();
+#endif
+}
+
 static void proof_goal_found(slice_index si, stip_structure_traversal *st)
 {
   boolean * const result = st->param;
@@ -1735,7 +2321,7 @@ static void inithash(slice_index si)
   TraceFunctionParam("%u",si);
   TraceFunctionParamListEnd();
 
-  assert(pyhash==0);
+  assert(pyhash==0 || is_table_kept);
 
   ifTESTHASH(fprintf(stdout,"calling inithash\n"));
 
@@ -1743,18 +2329,19 @@ static void inithash(slice_index si)
   OldBreak= sbrk(0);
 #endif /*__unix,TESTHASH*/
 
-  minimalElementValueAfterCompression = 2;
-
   init_slice_properties(si);
+  init_stipulation_fingerprint(si);
 
   template_element.d.Data = 0;
   init_elements(&template_element);
 
-  is_table_uncompressed = true;     /* V3.60  TLi */
-
   dhtRegisterValue(dhtBCMemValue,0,&dhtBCMemoryProcs);
   dhtRegisterValue(dhtSimpleValue,0,&dhtSimpleProcs);
 
+  hashBufferProcs = dhtBCMemoryProcs;
+  hashBufferProcs.Hash = &ConvertHashBuffer;
+  dhtRegisterValue(dhtUser1Value,"HashBuffer",&hashBufferProcs);
+
   ifHASHRATE(use_pos = use_all = 0);
 
   /* check whether a piece can be coded in a single byte */
@@ -1780,6 +2367,8 @@ static void inithash(slice_index si)
 
   bytes_per_piece= one_byte_hash ? 1 : 1+bytes_per_spec;
 
+  are_piece_ids_encoded = !one_byte_hash && (some_pieces_flags&PieceIdMask)!=0;
+
   if (is_proofgame(si))
   {
     encode = ProofEncode;
@@ -1818,9 +2407,44 @@ static void inithash(slice_index si)
   fxfInfo(stdout);
 #endif /*TESTHASH,FXF*/
 
-#if defined(FXF)
-  fxfReset();
-#endif
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Release the memory of the hash table
+ */
+static void destroy_table(void)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  dhtDestroy(pyhash);
+  pyhash = 0;
+
+  if (is_bucket_table_used)
+  {
+    lockless_hash_free();
+    is_bucket_table_used = false;
+    is_hash_file_used = false;
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Release the hash table kept from the previous twin, if any; the positions
+ * stored may not be valid any more if the conditions have changed
+ */
+void hash_discard_kept_table(void)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  if (is_table_kept)
+  {
+    destroy_table();
+    is_table_kept = false;
+  }
 
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
@@ -1831,9 +2455,43 @@ static void openhash(void)
   TraceFunctionEntry(__func__);
   TraceFunctionParamListEnd();
 
-  assert(pyhash==0);
-  pyhash = dhtCreate(dhtBCMemValue,dhtCopy,dhtSimpleValue,dhtNoCopy);
-  assert(pyhash!=0);
+  if (is_table_kept)
+  {
+    is_table_kept = false;
+    if (compute_table_fingerprint()!=table_fingerprint)
+      destroy_table();
+  }
+
+  if (pyhash==0)
+  {
+    table_fingerprint = compute_table_fingerprint();
+
+    minimalElementValueAfterCompression = 2;
+    is_table_uncompressed = true;     /* V3.60  TLi */
+
+    reset_arena();
+
+    pyhash = dhtCreate(dhtUser1Value,dhtCopy,dhtSimpleValue,dhtNoCopy);
+    assert(pyhash!=0);
+
+    /* the table has to be allocated before the workers are started;
+     * solutions stopped short of completeness by option stoponshort would
+     * leave values in the table that don't hold */
+    is_hash_file_used = (hash_file_prefix!=0
+                         && is_table_reusable
+                         && !OptFlag[stoponshort]
+                         && allocate_bucket_table_in_file());
+    is_bucket_table_used = (is_hash_file_used
+                            || ((is_bucket_table_requested
+                                 || root_move_splitter_is_enabled())
+                                && lockless_hash_allocate(hashtable_kilos-lent_kilos)>0));
+  }
+
+  /* the bucket table only holds keys, so there is no need for encoding the
+   * board if its key identifies it */
+  encode_dht = encode;
+  if (is_bucket_table_used && !are_piece_ids_encoded)
+    encode = &KeyEncode;
 
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
@@ -1878,8 +2536,17 @@ static void closehash(void)
 #endif /*__unix*/
 #endif /*TESTHASH*/
 
-  dhtDestroy(pyhash);
-  pyhash = 0;
+  encode = encode_dht;
+
+  /* the positions of the file are kept anyway; piece ids may refer to
+   * different pieces in the next twin */
+  if (is_keeping_requested
+      && is_table_reusable
+      && !is_hash_file_used
+      && !are_piece_ids_encoded)
+    is_table_kept = true;
+  else
+    destroy_table();
 
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
@@ -1946,7 +2613,10 @@ static void insert_hash_element_attack(slice_index si,
   TraceFunctionParam("%u",si);
   TraceFunctionParamListEnd();
 
-  if (state->previous_move_slice!=no_slice && length>slack_length)
+  /* proof-number search keeps its own table; this one would remember the
+   * provisional results of the nodes that haven't been searched yet */
+  if (state->previous_move_slice!=no_slice && length>slack_length
+      && !OptFlag[proofnumbers])
   {
     slice_index const prototype = alloc_branch(STAttackHashed,length,min_length);
     attack_branch_insert_slices(si,&prototype,1);
@@ -2078,6 +2748,8 @@ void solving_insert_hashing(slice_index si)
     pipe_append(SLICE_TESTER(si),SLICE_TESTER(opener));
   }
 
+  is_table_reusable = !state.opener_inserted;
+
   inithash(si);
 
   TraceFunctionExit(__func__);
@@ -2120,26 +2792,26 @@ static void addtohash_battle_nosuccess(slice_index si,
                                        stip_length_type n,
                                        stip_length_type min_length_adjusted)
 {
-  HashBuffer const * const hb = &hashBuffers[nbply];
   hash_value_type const val = (n+1-min_length_adjusted)/2;
-  dhtElement *he;
+  hashElement_union_t copy;
+  hashElement_union_t *hue;
 
   TraceFunctionEntry(__func__);
   TraceFunctionParam("%u",si);
   TraceFunctionParam("%u",min_length_adjusted);
   TraceFunctionParamListEnd();
 
-  he = dhtLookupElement(pyhash,hb);
-  if (he==dhtNilElement)
+  hue = find_element(&copy);
+  if (hue==0)
   {
-    hashElement_union_t * const hue = (hashElement_union_t *)allocDHTelement(hb);
+    hue = enter_element(&copy);
     set_value_attack_nosuccess(hue,si,val);
+    element_modified(hue);
   }
-  else
+  else if (get_value_attack_nosuccess(hue,si)<val)
   {
-    hashElement_union_t * const hue = (hashElement_union_t *)he;
-    if (get_value_attack_nosuccess(hue,si)<val)
-      set_value_attack_nosuccess(hue,si,val);
+    set_value_attack_nosuccess(hue,si,val);
+    element_modified(hue);
   }
 
   TraceFunctionExit(__func__);
@@ -2160,27 +2832,26 @@ static void addtohash_battle_success(slice_index si,
                                      stip_length_type n,
                                      stip_length_type min_length_adjusted)
 {
-  HashBuffer const * const hb = &hashBuffers[nbply];
   hash_value_type const val = (n+1-min_length_adjusted)/2 - 1;
-  dhtElement *he;
+  hashElement_union_t copy;
+  hashElement_union_t *hue;
 
   TraceFunctionEntry(__func__);
   TraceFunctionParam("%u",si);
   TraceFunctionParam("%u",min_length_adjusted);
   TraceFunctionParamListEnd();
 
-  he = dhtLookupElement(pyhash,hb);
-  if (he==dhtNilElement)
+  hue = find_element(&copy);
+  if (hue==0)
   {
-    hashElement_union_t * const
-        hue = (hashElement_union_t *)allocDHTelement(hb);
+    hue = enter_element(&copy);
     set_value_attack_success(hue,si,val);
+    element_modified(hue);
   }
-  else
+  else if (get_value_attack_success(hue,si)>val)
   {
-    hashElement_union_t * const hue = (hashElement_union_t *)he;
-    if (get_value_attack_success(hue,si)>val)
-      set_value_attack_success(hue,si,val);
+    set_value_attack_success(hue,si,val);
+    element_modified(hue);
   }
 
   TraceFunctionExit(__func__);
@@ -2234,7 +2905,8 @@ stip_length_type delegate_can_attack_in_n(slice_index si,
  */
 void attack_hashed_tester_solve(slice_index si)
 {
-  dhtElement const *he;
+  hashElement_union_t copy;
+  hashElement_union_t const *hue;
   slice_index const base = SLICE_U(si).derived_pipe.base;
   stip_length_type const min_length = SLICE_U(base).branch.min_length;
   stip_length_type const played = SLICE_U(base).branch.length-solve_nr_remaining;
@@ -2252,12 +2924,11 @@ void attack_hashed_tester_solve(slice_index si)
 
   (*encode)(min_length,validity_value);
 
-  he = dhtLookupElement(pyhash,&hashBuffers[nbply]);
-  if (he==dhtNilElement)
+  hue = find_element(&copy);
+  if (hue==0)
     solve_result = delegate_can_attack_in_n(si,min_length_adjusted);
   else
   {
-    hashElement_union_t const * const hue = (hashElement_union_t const *)he;
     stip_length_type const parity = (solve_nr_remaining-min_length_adjusted)%2;
 
     /* It is more likely that a position has no solution. */
@@ -2303,8 +2974,8 @@ void attack_hashed_tester_solve(slice_index si)
 static boolean inhash_help(slice_index si)
 {
   boolean result;
-  HashBuffer *hb = &hashBuffers[nbply];
-  dhtElement const *he;
+  hashElement_union_t copy;
+  hashElement_union_t const *hue;
   stip_length_type const validity_value = (solve_nr_remaining-1)/2+1;
 
   TraceFunctionEntry(__func__);
@@ -2322,10 +2993,10 @@ static boolean inhash_help(slice_index si)
 
   ifHASHRATE(use_all++);
 
-  he = dhtLookupElement(pyhash,hb);
-  if (he==dhtNilElement)
+  hue = find_element(&copy);
+  if (hue==0)
     result = false;
-  else if (get_value_help((hashElement_union_t const *)he,si)==1)
+  else if (get_value_help(hue,si)==1)
   {
     ifHASHRATE(use_pos++);
     result = true;
@@ -2345,21 +3016,19 @@ static boolean inhash_help(slice_index si)
  */
 static void addtohash_help(slice_index si)
 {
-  HashBuffer const * const hb = &hashBuffers[nbply];
-  dhtElement *he;
-  hashElement_union_t * hue;
+  hashElement_union_t copy;
+  hashElement_union_t *hue;
 
   TraceFunctionEntry(__func__);
   TraceFunctionParam("%u",si);
   TraceFunctionParamListEnd();
 
-  he = dhtLookupElement(pyhash,hb);
-  if (he==dhtNilElement)
-    hue = (hashElement_union_t *)allocDHTelement(hb);
-  else
-    hue = (hashElement_union_t *)he;
+  hue = find_element(&copy);
+  if (hue==0)
+    hue = enter_element(&copy);
 
   set_value_help(hue,si,1);
+  element_modified(hue);
 
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
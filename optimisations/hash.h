@@ -49,6 +49,39 @@ void check_hash_assumptions(void);
  */
 unsigned long allochash(unsigned long nr_kilos);
 
+/* Lend part of the memory of the hash table to another table of the solving
+ * machinery (e.g. the node table of option ProofNumbers) while the current
+ * twin is solved. The hash table is then created with the rest of the memory.
+ * To be invoked before the hash table is opened.
+ * @param nr_kilos number of kilo-bytes wanted; 0 to take the memory back
+ * @return number of kilo-bytes lent; at most half of the memory
+ */
+unsigned long hash_lend_memory(unsigned long nr_kilos);
+
+/* Store positions in a table of fixed size buckets where a new position
+ * replaces a less valuable one, rather than in a table that has to be
+ * compressed when it is full
+ */
+void hash_request_bucket_table(void);
+
+/* Hold the bucket table in a file that survives the process, and take over
+ * the table from the file when the same problem is solved again.
+ * The name of the file consists of a prefix and a fingerprint of the problem
+ * and the twin.
+ * @param prefix prefix of the file name
+ */
+void hash_request_file(char const *prefix);
+
+/* Keep the hash table from one twin to the next as long as the positions
+ * stored remain valid, i.e. unless the stipulation or the conditions change
+ */
+void hash_request_keeping_across_twins(void);
+
+/* Release the hash table kept from the previous twin, if any; the positions
+ * stored may not be valid any more if the conditions have changed
+ */
+void hash_discard_kept_table(void);
+
 /* Determine whether the hash table has been successfully allocated
  * @return true iff the hashtable has been allocated
  */
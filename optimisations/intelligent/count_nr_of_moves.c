@@ -11,6 +11,7 @@
 #include "pieces/pieces.h"
 
 #include "debugging/assert.h"
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -44,7 +45,83 @@ int const minimum_number_knight_moves[square_h8-square_a1+1]=
   /* 161-175 */     6,  5,  4,  5,  4,  5,  4,  5,  4, 5, 4, 5, 4, 5, 6
 };
 
+/* minimal numbers of moves of the orthodox pieces from a square to another
+ * one, ignoring obstacles, checks and castling; indexed by the indices of the
+ * squares in the sets of squares (see square_set_index()).
+ * The numbers for promoting pawns include the moves of the promotee from the
+ * most favourable promotion square.
+ */
+enum
+{
+  distance_unreachable = UCHAR_MAX, /* stands for maxply+1 */
+  nr_officer_walks = Bishop-Queen+1
+};
+
+static unsigned char king_distance[nr_squares_on_board][nr_squares_on_board];
+static unsigned char officer_distance[nr_officer_walks][nr_squares_on_board][nr_squares_on_board];
+static unsigned char pawn_distance[nr_sides][nr_squares_on_board][nr_squares_on_board];
+static unsigned char promotion_distance[nr_sides][nr_officer_walks][nr_squares_on_board][nr_squares_on_board];
+
+static unsigned int decode_distance(unsigned char distance)
+{
+  return distance==distance_unreachable ? maxply+1 : distance;
+}
+
+static unsigned char encode_distance(unsigned int nr_moves)
+{
+  if (nr_moves>maxply)
+    return distance_unreachable;
+  else
+  {
+    assert(nr_moves<distance_unreachable);
+    return (unsigned char)nr_moves;
+  }
+}
+
 static unsigned int king_no_castling(square from, square to)
+{
+  return king_distance[square_set_index(from)][square_set_index(to)];
+}
+
+static unsigned int black_pawn_no_promotion(square from_square, square to_square)
+{
+  return decode_distance(pawn_distance[Black][square_set_index(from_square)][square_set_index(to_square)]);
+}
+
+static unsigned int white_pawn_no_promotion(square from_square, square to_square)
+{
+  return decode_distance(pawn_distance[White][square_set_index(from_square)][square_set_index(to_square)]);
+}
+
+static unsigned int officer_from_to(piece_walk_type piece, square from_square, square to_square)
+{
+  assert(piece>=Queen && piece<=Bishop);
+  return decode_distance(officer_distance[piece-Queen][square_set_index(from_square)][square_set_index(to_square)]);
+}
+
+static unsigned int officer(piece_walk_type piece, square from_square, square to_square)
+{
+  assert(from_square!=to_square);
+  return officer_from_to(piece,from_square,to_square);
+}
+
+static unsigned int white_pawn_promotion(square from_square,
+                                         piece_walk_type to_piece,
+                                         square to_square)
+{
+  assert(to_piece>=Queen && to_piece<=Bishop);
+  return decode_distance(promotion_distance[White][to_piece-Queen][square_set_index(from_square)][square_set_index(to_square)]);
+}
+
+static unsigned int black_pawn_promotion(square from_square,
+                                         piece_walk_type to_piece,
+                                         square to_square)
+{
+  assert(to_piece>=Queen && to_piece<=Bishop);
+  return decode_distance(promotion_distance[Black][to_piece-Queen][square_set_index(from_square)][square_set_index(to_square)]);
+}
+
+static unsigned int calculate_king_no_castling(square from, square to)
 {
   unsigned int const diffcol = abs(from%onerow - to%onerow);
   unsigned int const diffrow = abs(from/onerow - to/onerow);
@@ -118,7 +195,7 @@ static unsigned int black_king(square from_square, square to_square)
   return result;
 }
 
-static unsigned int black_pawn_no_promotion(square from_square, square to_square)
+static unsigned int calculate_black_pawn_no_promotion(square from_square, square to_square)
 {
   unsigned int result;
   int const diffcol = abs(from_square%onerow - to_square%onerow);
@@ -138,8 +215,8 @@ static unsigned int black_pawn_no_promotion(square from_square, square to_square
   return result;
 }
 
-static unsigned int white_pawn_no_promotion(square from_square,
-                                            square to_square)
+static unsigned int calculate_white_pawn_no_promotion(square from_square,
+                                                      square to_square)
 {
   unsigned int result;
   int const diffcol = abs(from_square%onerow - to_square%onerow);
@@ -238,7 +315,7 @@ static unsigned int knight(square from_square, square to_square)
   return result;
 }
 
-static unsigned int officer(piece_walk_type piece, square from_square, square to_square)
+static unsigned int calculate_officer(piece_walk_type piece, square from_square, square to_square)
 {
   unsigned int result;
 
@@ -279,9 +356,9 @@ static unsigned int officer(piece_walk_type piece, square from_square, square to
   return result;
 }
 
-static unsigned int white_pawn_promotion(square from_square,
-                                         piece_walk_type to_piece,
-                                         square to_square)
+static unsigned int calculate_white_pawn_promotion(square from_square,
+                                                   piece_walk_type to_piece,
+                                                   square to_square)
 {
   unsigned int result = maxply+1;
   square prom_square;
@@ -294,11 +371,11 @@ static unsigned int white_pawn_promotion(square from_square,
 
   for (prom_square = square_a8; prom_square<=square_h8; prom_square += dir_right)
   {
-    unsigned int const to_prom = white_pawn_no_promotion(from_square,
-                                                         prom_square);
+    unsigned int const to_prom = calculate_white_pawn_no_promotion(from_square,
+                                                                   prom_square);
     unsigned int const from_prom = (prom_square==to_square
                                     ? 0
-                                    : officer(to_piece,prom_square,to_square));
+                                    : calculate_officer(to_piece,prom_square,to_square));
     unsigned int const total = to_prom+from_prom;
     if (total<result)
       result = total;
@@ -310,9 +387,9 @@ static unsigned int white_pawn_promotion(square from_square,
   return result;
 }
 
-static unsigned int black_pawn_promotion(square from_square,
-                                         piece_walk_type to_piece,
-                                         square to_square)
+static unsigned int calculate_black_pawn_promotion(square from_square,
+                                                   piece_walk_type to_piece,
+                                                   square to_square)
 {
   unsigned int result = maxply+1;
   square prom_square;
@@ -325,11 +402,11 @@ static unsigned int black_pawn_promotion(square from_square,
 
   for (prom_square = square_a1; prom_square<=square_h1; prom_square += dir_right)
   {
-    unsigned int const to_prom = black_pawn_no_promotion(from_square,
-                                                         prom_square);
+    unsigned int const to_prom = calculate_black_pawn_no_promotion(from_square,
+                                                                   prom_square);
     unsigned int const from_prom = (prom_square==to_square
                                     ? 0
-                                    : officer(to_piece,prom_square,to_square));
+                                    : calculate_officer(to_piece,prom_square,to_square));
     unsigned int const total = to_prom+from_prom;
     if (total<result)
       result = total;
@@ -341,6 +418,55 @@ static unsigned int black_pawn_promotion(square from_square,
   return result;
 }
 
+/* Initialise the tables of the minimal numbers of moves of the orthodox pieces
+ * @note the tables only depend on the geometry of the board, so they are
+ *       initialised once
+ */
+void intelligent_init_distance_tables(void)
+{
+  static boolean are_tables_initialised = false;
+  unsigned int i;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  if (!are_tables_initialised)
+  {
+    for (i = 0; i!=nr_squares_on_board; ++i)
+    {
+      square const from_square = boardnum[i];
+      unsigned int j;
+
+      for (j = 0; j!=nr_squares_on_board; ++j)
+      {
+        square const to_square = boardnum[j];
+        piece_walk_type walk;
+
+        king_distance[i][j] = encode_distance(calculate_king_no_castling(from_square,to_square));
+
+        officer_distance[Queen-Queen][i][j] = encode_distance(queen(from_square,to_square));
+        officer_distance[Knight-Queen][i][j] = encode_distance(knight(from_square,to_square));
+        officer_distance[Rook-Queen][i][j] = encode_distance(rook(from_square,to_square));
+        officer_distance[Bishop-Queen][i][j] = encode_distance(bishop(from_square,to_square));
+
+        pawn_distance[White][i][j] = encode_distance(calculate_white_pawn_no_promotion(from_square,to_square));
+        pawn_distance[Black][i][j] = encode_distance(calculate_black_pawn_no_promotion(from_square,to_square));
+
+        for (walk = Queen; walk<=Bishop; ++walk)
+        {
+          promotion_distance[White][walk-Queen][i][j] = encode_distance(calculate_white_pawn_promotion(from_square,walk,to_square));
+          promotion_distance[Black][walk-Queen][i][j] = encode_distance(calculate_black_pawn_promotion(from_square,walk,to_square));
+        }
+      }
+    }
+
+    are_tables_initialised = true;
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
 static unsigned int from_to_different(Side side,
                                       piece_walk_type from_piece,
                                       square from_square,
@@ -364,19 +490,10 @@ static unsigned int from_to_different(Side side,
       break;
 
     case Queen:
-      result = queen(from_square,to_square);
-      break;
-
     case Rook:
-      result = rook(from_square,to_square);
-      break;
-
     case Bishop:
-      result = bishop(from_square,to_square);
-      break;
-
     case Knight:
-      result = knight(from_square,to_square);
+      result = officer_from_to(from_piece,from_square,to_square);
       break;
 
     case Pawn:
@@ -9,6 +9,10 @@
 
 extern int const minimum_number_knight_moves[];
 
+/* Initialise the tables of the minimal numbers of moves of the orthodox pieces
+ */
+void intelligent_init_distance_tables(void);
+
 /* Count the number of moves required for promotiong a white pawn
  * @param from_square start square of the pawn
  * @return number of moves required if promotion is possible
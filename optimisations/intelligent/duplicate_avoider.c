@@ -8,6 +8,7 @@
 #include "solving/move_effect_journal.h"
 #include "debugging/trace.h"
 #include "pieces/pieces.h"
+#include "platform/worker.h"
 
 #include "debugging/assert.h"
 #include <stdio.h>
@@ -207,7 +208,10 @@ void intelligent_solution_rememberer_solve(slice_index si)
   TraceFunctionParam("%u",si);
   TraceFunctionParamListEnd();
 
+  /* the same solution may be found by several workers */
+  platform_worker_begin_output_item();
   pipe_solve_delegate(si);
+  platform_worker_end_output_item();
 
   if (move_has_solved())
     store_solution();
@@ -427,6 +427,8 @@ void IntelligentRegulargoal_types(slice_index si)
   TraceFunctionEntry(__func__);
   TraceFunctionParamListEnd();
 
+  intelligent_init_distance_tables();
+
   if (being_solved.king_square[Black]!=initsquare)
   {
     testcastling = (   TSTCASTLINGFLAGMASK(White,q_castling)==q_castling
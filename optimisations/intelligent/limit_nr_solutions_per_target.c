@@ -7,6 +7,7 @@
 #include "solving/has_solution_type.h"
 #include "solving/pipe.h"
 #include "solving/incomplete.h"
+#include "options/movenumbers/root_move_splitter.h"
 #include "debugging/trace.h"
 #include "debugging/assert.h"
 
@@ -123,6 +124,9 @@ void intelligent_nr_solutions_per_target_position_solving_instrumenter_solve(sli
     stip_traverse_structure(si,&st);
   }
 
+  /* the workers can't share the numbers of solutions per target position */
+  solving_remove_root_move_splitters(si);
+
   pipe_solve_delegate(si);
 
   TraceFunctionExit(__func__);
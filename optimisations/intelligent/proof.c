@@ -20,7 +20,9 @@
 #include "debugging/assert.h"
 #include "debugging/trace.h"
 
+#include <limits.h>
 #include <stdlib.h>
+#include <string.h>
 
 static boolean ProofFairy;
 
@@ -53,6 +55,18 @@ static PieceList ProofPawns[nr_sides];
 static PieceList PawnsToBeArranged[nr_sides];
 static PieceList ProofOfficers[nr_sides];
 static PieceList PiecesToBeArranged[nr_sides];
+static PieceList PawnsOnBoard[nr_sides];
+
+/* pawns of the target position that can't have moved */
+static square_set_type UnmovedPawns[nr_sides];
+
+/* pawns that block the ways of the officers; determined before the officers
+ * are arranged */
+static square_set_type SquaresBlockedByPawns;
+
+/* squares between two squares on a common line, indexed by the indices of the
+ * squares in the sets of squares (see square_set_index()) */
+static square_set_type SquaresBetween[nr_squares_on_board][nr_squares_on_board];
 
 static unsigned int ProofNbrPieces[nr_sides];
 
@@ -277,14 +291,41 @@ static stip_length_type PawnMovesNeeded(Side side, square sq)
   }
 }
 
+/* Determine the pawns that have reached their target squares and can't be
+ * replaced there by other pawns, i.e. that block the ways of the officers
+ */
+static void find_squares_blocked_by_pawns(void)
+{
+  Side side;
+
+  SquaresBlockedByPawns = 0;
+
+  for (side = White; side<=Black; ++side)
+  {
+    square_set_type pawns = (get_squares_occupied_by_walk(side,Pawn)
+                             & proofgames_target_position.occupied[side]
+                             & proofgames_target_position.occupied_by_walk[Pawn]);
+    while (pawns!=0)
+    {
+      square const sq = square_set_pop_first(&pawns);
+      if (PawnMovesNeeded(side,sq)>=current_length)
+        SquaresBlockedByPawns |= square_set_element(sq);
+    }
+  }
+}
+
 static boolean blocked_by_pawn(square sq)
 {
-  return (((get_walk_of_piece_on_square(sq)==Pawn && TSTFLAG(being_solved.spec[sq],White))
-           && (proofgames_target_position.board[sq]==Pawn && TSTFLAG(proofgames_target_position.spec[sq],White))
-           && PawnMovesNeeded(White,sq)>=current_length)
-          || ((get_walk_of_piece_on_square(sq)==Pawn && TSTFLAG(being_solved.spec[sq],Black))
-              && (proofgames_target_position.board[sq]==Pawn && TSTFLAG(proofgames_target_position.spec[sq],Black))
-              && PawnMovesNeeded(Black,sq)>=current_length));
+  return (SquaresBlockedByPawns&square_set_element(sq))!=0;
+}
+
+/* Determine whether a line piece can go from one square to another without
+ * being blocked by a pawn
+ */
+static boolean is_line_blocked_by_pawn(square from, square to)
+{
+  return (SquaresBetween[square_set_index(from)][square_set_index(to)]
+          & SquaresBlockedByPawns)!=0;
 }
 
 static void OfficerMovesFromTo(piece_walk_type p,
@@ -312,13 +353,13 @@ static void OfficerMovesFromTo(piece_walk_type p,
         for (i= vec_knight_start; i<=vec_knight_end; ++i)
         {
           sqi= from+vec[i];
-          if (!blocked_by_pawn(sqi) && !is_square_blocked(sqi))
+          if (!is_square_blocked(sqi) && !blocked_by_pawn(sqi))
           {
             vec_index_type j;
             for (j= vec_knight_start; j<=vec_knight_end; j++)
             {
               sqj= to+vec[j];
-              if (!blocked_by_pawn(sqj) && !is_square_blocked(sqj))
+              if (!is_square_blocked(sqj) && !blocked_by_pawn(sqj))
               {
                 testmov= minimum_number_knight_moves[abs(sqi-sqj)]+2;
                 if (testmov == *moves)
@@ -340,12 +381,7 @@ static void OfficerMovesFromTo(piece_walk_type p,
       {
         dir= CheckDir[Bishop][sqdiff];
         if (dir)
-        {
-          do {
-            from-= dir;
-          } while (to != from && !blocked_by_pawn(from));
-          *moves= to == from ? 1 : 3;
-        }
+          *moves= is_line_blocked_by_pawn(from,to) ? 3 : 1;
         else
           *moves= 2;
       }
@@ -354,12 +390,7 @@ static void OfficerMovesFromTo(piece_walk_type p,
     case Rook:
       dir= CheckDir[Rook][sqdiff];
       if (dir)
-      {
-        do {
-          from-= dir;
-        } while (to != from && !blocked_by_pawn(from));
-        *moves= to == from ? 1 : 3;
-      }
+        *moves= is_line_blocked_by_pawn(from,to) ? 3 : 1;
       else
         *moves= 2;
       break;
@@ -367,12 +398,7 @@ static void OfficerMovesFromTo(piece_walk_type p,
     case Queen:
       dir= CheckDir[Queen][sqdiff];
       if (dir)
-      {
-        do {
-          from-= dir;
-        } while (to != from && !blocked_by_pawn(from));
-        *moves= to == from ? 1 : 2;
-      }
+        *moves= is_line_blocked_by_pawn(from,to) ? 2 : 1;
       else
         *moves= 2;
       break;
@@ -484,17 +510,26 @@ static void PieceMovesFromTo(Side side,
   TraceFunctionResultEnd();
 }
 
-static stip_length_type ArrangeListedPieces(
-  PieceList2    *pl,
-  int       nto,
-  int       nfrom,
-  boolean   *taken,
-  stip_length_type CapturesAllowed)
+/* Determine the minimal number of moves for arranging pieces on all targets
+ * by trying all assignments of pieces to targets
+ * @param pl the pieces that can reach each target and how
+ * @param nto number of targets
+ * @param taken which pieces have already been assigned to a target
+ * @param CapturesAllowed number of captures available
+ * @param bound assignments requiring this number of moves or more aren't
+ *              interesting
+ * @return minimum of bound and the minimal number of moves
+ */
+static stip_length_type ArrangeListedPieces(PieceList2 const *pl,
+                                            int nto,
+                                            boolean *taken,
+                                            stip_length_type CapturesAllowed,
+                                            stip_length_type bound)
 {
   stip_length_type Diff, Diff2;
   int i, id;
 
-  Diff= current_length;
+  Diff= bound;
 
   if (nto == 0)
     return 0;
@@ -502,13 +537,14 @@ static stip_length_type ArrangeListedPieces(
   for (i= 0; i < pl[0].Nbr; ++i)
   {
     id= pl[0].id[i];
-    if (taken[id] || pl[0].captures[i]>CapturesAllowed)
+    if (taken[id] || pl[0].captures[i]>CapturesAllowed || pl[0].moves[i]>=Diff)
       continue;
 
     taken[id]= true;
     Diff2= pl[0].moves[i]
-      + ArrangeListedPieces(pl+1, nto-1, nfrom,
-                            taken, CapturesAllowed-pl[0].captures[i]);
+      + ArrangeListedPieces(pl+1, nto-1,
+                            taken, CapturesAllowed-pl[0].captures[i],
+                            Diff-pl[0].moves[i]);
 
     if (Diff2 < Diff)
       Diff= Diff2;
@@ -519,6 +555,263 @@ static stip_length_type ArrangeListedPieces(
   return Diff;
 }
 
+/* Find an assignment of distinct pieces to all targets that minimises the
+ * number of moves or the number of captures (Hungarian method)
+ * @param pl the pieces that can reach each target and how
+ * @param nto number of targets
+ * @param nfrom number of pieces
+ * @param captures_first true: minimise the number of captures, then the number
+ *                       of moves; false: the other way round
+ * @param moves where to store the number of moves of the assignment found
+ * @param captures where to store the number of captures of the assignment
+ *                 found
+ * @return false iff there is no assignment
+ */
+static boolean AssignListedPieces(PieceList2 const *pl,
+                                  int nto,
+                                  int nfrom,
+                                  boolean captures_first,
+                                  stip_length_type *moves,
+                                  stip_length_type *captures)
+{
+  /* the number of moves and captures of each of the <=16 pairs of piece and
+   * target are <current_length and <nr_files_on_board, respectively */
+  long const weight = (captures_first
+                       ? 16L*current_length
+                       : 16L*nr_files_on_board);
+  long const unassignable = (captures_first
+                             ? 16L*nr_files_on_board*weight
+                             : 16L*current_length*weight);
+  long const infinity = LONG_MAX/2;
+  long cost[17][17];
+  long u[17];
+  long v[17];
+  long minv[17];
+  int p[17];
+  int way[17];
+  boolean used[17];
+  int i, j, k;
+
+  if (nto>nfrom)
+    return false;
+
+  for (i = 1; i<=nto; ++i)
+  {
+    for (j = 1; j<=nfrom; ++j)
+      cost[i][j] = unassignable;
+
+    for (k = 0; k<pl[i-1].Nbr; ++k)
+      cost[i][pl[i-1].id[k]+1] = (captures_first
+                                  ? pl[i-1].captures[k]*weight+pl[i-1].moves[k]
+                                  : pl[i-1].moves[k]*weight+pl[i-1].captures[k]);
+  }
+
+  for (i = 0; i<=nto; ++i)
+    u[i] = 0;
+  for (j = 0; j<=nfrom; ++j)
+  {
+    v[j] = 0;
+    p[j] = 0;
+  }
+
+  /* add the targets one by one, each time along a shortest augmenting path */
+  for (i = 1; i<=nto; ++i)
+  {
+    int j0 = 0;
+
+    p[0] = i;
+    for (j = 0; j<=nfrom; ++j)
+    {
+      minv[j] = infinity;
+      used[j] = false;
+    }
+
+    do
+    {
+      int const i0 = p[j0];
+      long delta = infinity;
+      int j1 = 0;
+
+      used[j0] = true;
+
+      for (j = 1; j<=nfrom; ++j)
+        if (!used[j])
+        {
+          long const reduced = cost[i0][j]-u[i0]-v[j];
+          if (reduced<minv[j])
+          {
+            minv[j] = reduced;
+            way[j] = j0;
+          }
+          if (minv[j]<delta)
+          {
+            delta = minv[j];
+            j1 = j;
+          }
+        }
+
+      for (j = 0; j<=nfrom; ++j)
+        if (used[j])
+        {
+          u[p[j]] += delta;
+          v[j] -= delta;
+        }
+        else
+          minv[j] -= delta;
+
+      j0 = j1;
+    } while (p[j0]!=0);
+
+    do
+    {
+      int const j1 = way[j0];
+      p[j0] = p[j1];
+      j0 = j1;
+    } while (j0!=0);
+  }
+
+  *moves = 0;
+  *captures = 0;
+
+  for (j = 1; j<=nfrom; ++j)
+    if (p[j]!=0)
+    {
+      long const c = cost[p[j]][j];
+      if (c==unassignable)
+        return false;
+      else if (captures_first)
+      {
+        *captures += c/weight;
+        *moves += c%weight;
+      }
+      else
+      {
+        *moves += c/weight;
+        *captures += c%weight;
+      }
+    }
+
+  return true;
+}
+
+/* Determine the minimal number of moves for arranging pieces on all targets
+ * @param pl the pieces that can reach each target and how
+ * @param nto number of targets
+ * @param nfrom number of pieces
+ * @param CapturesAllowed number of captures available
+ * @return minimal number of moves; current_length if the pieces can't be
+ *         arranged in less than current_length moves
+ */
+static stip_length_type ArrangeListedPiecesWithin(PieceList2 const *pl,
+                                                  int nto,
+                                                  int nfrom,
+                                                  stip_length_type CapturesAllowed)
+{
+  stip_length_type result;
+  stip_length_type moves_min;
+  stip_length_type captures;
+
+  if (!AssignListedPieces(pl,nto,nfrom,false,&moves_min,&captures))
+    result = current_length;
+  else if (captures<=CapturesAllowed)
+    result = moves_min<current_length ? moves_min : current_length;
+  else
+  {
+    stip_length_type moves;
+
+    if (!AssignListedPieces(pl,nto,nfrom,true,&moves,&captures)
+        || captures>CapturesAllowed)
+      result = current_length;
+    else if (moves==moves_min)
+      result = moves<current_length ? moves : current_length;
+    else
+    {
+      /* the assignments using fewer moves use too many captures */
+      boolean taken[16];
+      int ifrom;
+
+      for (ifrom = 0; ifrom<nfrom; ++ifrom)
+        taken[ifrom] = false;
+
+      result = ArrangeListedPieces(pl,nto,taken,CapturesAllowed,
+                                   moves<current_length ? moves : current_length);
+    }
+  }
+
+  return result;
+}
+
+/* Memo of the results of ArrangePawns() and ArrangePieces(). The arrangement
+ * of one side often doesn't change while the other side moves its officers.
+ */
+enum
+{
+  arrangement_memo_size = 1<<12,
+  max_arrangement_key_length = 72
+};
+
+typedef struct
+{
+    unsigned int length;
+    unsigned short key[max_arrangement_key_length];
+} arrangement_key_type;
+
+typedef struct
+{
+    arrangement_key_type key;
+    stip_length_type moves;
+    stip_length_type captures_required;
+} arrangement_memo_entry_type;
+
+static arrangement_memo_entry_type arrangement_memo[arrangement_memo_size];
+
+static void forget_arrangements(void)
+{
+  unsigned int i;
+  for (i = 0; i!=arrangement_memo_size; ++i)
+    arrangement_memo[i].key.length = 0;
+}
+
+static void arrangement_key_append(arrangement_key_type *key, unsigned int value)
+{
+  assert(key->length<max_arrangement_key_length);
+  key->key[key->length] = (unsigned short)value;
+  ++key->length;
+}
+
+static void arrangement_key_append_list(arrangement_key_type *key,
+                                        PieceList const *list,
+                                        boolean with_walks)
+{
+  int i;
+
+  arrangement_key_append(key,(unsigned int)list->Nbr);
+  for (i = 0; i<list->Nbr; ++i)
+  {
+    arrangement_key_append(key,(unsigned int)list->sq[i]);
+    if (with_walks)
+      arrangement_key_append(key,get_walk_of_piece_on_square(list->sq[i]));
+  }
+}
+
+static arrangement_memo_entry_type *find_arrangement(arrangement_key_type const *key)
+{
+  unsigned long hash = 2166136261UL;
+  unsigned int i;
+
+  for (i = 0; i!=key->length; ++i)
+    hash = (hash^key->key[i])*16777619UL;
+
+  return &arrangement_memo[hash&(arrangement_memo_size-1)];
+}
+
+static boolean is_arrangement_remembered(arrangement_memo_entry_type const *entry,
+                                         arrangement_key_type const *key)
+{
+  return (entry->key.length==key->length
+          && memcmp(entry->key.key,key->key,key->length*sizeof key->key[0])==0);
+}
+
 static stip_length_type ArrangePieces(stip_length_type CapturesAllowed,
                                       Side camp,
                                       stip_length_type CapturesRequired)
@@ -537,36 +830,56 @@ static stip_length_type ArrangePieces(stip_length_type CapturesAllowed,
   else
   {
     PieceList * const from = &PiecesToBeArranged[camp];
-    PieceList2 pl[16];
-    boolean   taken[16];
-    int ito;
-    int ifrom;
-
-    for (ito = 0; ito<to->Nbr; ito++)
+    arrangement_key_type key;
+    arrangement_memo_entry_type *entry;
+
+    key.length = 0;
+    arrangement_key_append(&key,nr_sides+camp);
+    arrangement_key_append(&key,CapturesAllowed);
+    arrangement_key_append(&key,CapturesRequired);
+    arrangement_key_append_list(&key,from,true);
+    arrangement_key_append_list(&key,to,false);
+    /* the pawns block the officers' ways */
+    arrangement_key_append_list(&key,&PawnsOnBoard[White],false);
+    arrangement_key_append_list(&key,&PawnsOnBoard[Black],false);
+
+    entry = find_arrangement(&key);
+    if (is_arrangement_remembered(entry,&key))
+      result = entry->moves;
+    else
     {
-      pl[ito].Nbr = 0;
-      for (ifrom = 0; ifrom<from->Nbr; ifrom++)
+      PieceList2 pl[16];
+      int ito;
+      int ifrom;
+
+      find_squares_blocked_by_pawns();
+
+      for (ito = 0; ito<to->Nbr; ito++)
       {
-        stip_length_type moves, captures;
-        PieceMovesFromTo(camp,
-                         from->sq[ifrom],
-                         to->sq[ito], &moves, &captures,
-                         CapturesAllowed, CapturesRequired);
-        if (moves<current_length)
+        pl[ito].Nbr = 0;
+        for (ifrom = 0; ifrom<from->Nbr; ifrom++)
         {
-          pl[ito].moves[pl[ito].Nbr]= moves;
-          pl[ito].captures[pl[ito].Nbr]= captures;
-          pl[ito].id[pl[ito].Nbr]= ifrom;
-          pl[ito].Nbr++;
+          stip_length_type moves, captures;
+          PieceMovesFromTo(camp,
+                           from->sq[ifrom],
+                           to->sq[ito], &moves, &captures,
+                           CapturesAllowed, CapturesRequired);
+          if (moves<current_length)
+          {
+            pl[ito].moves[pl[ito].Nbr]= moves;
+            pl[ito].captures[pl[ito].Nbr]= captures;
+            pl[ito].id[pl[ito].Nbr]= ifrom;
+            pl[ito].Nbr++;
+          }
         }
       }
-    }
 
-    for (ifrom = 0; ifrom<from->Nbr; ifrom++)
-      taken[ifrom]= false;
+      /* determine minimal number of moves required */
+      result = ArrangeListedPiecesWithin(pl,to->Nbr,from->Nbr,CapturesAllowed);
 
-    /* determine minimal number of moves required */
-    result = ArrangeListedPieces(pl,to->Nbr,from->Nbr,taken,CapturesAllowed);
+      entry->key = key;
+      entry->moves = result;
+    }
   }
 
   TraceFunctionExit(__func__);
@@ -582,7 +895,6 @@ static stip_length_type ArrangePawns(stip_length_type CapturesAllowed,
   int       ifrom, ito;
   stip_length_type moves, captures, Diff;
   PieceList2    pl[8];
-  boolean   taken[8];
   PieceList *from = &PawnsToBeArranged[camp];
   PieceList *to = &ProofPawns[camp];
 
@@ -598,41 +910,66 @@ static stip_length_type ArrangePawns(stip_length_type CapturesAllowed,
   }
   else
   {
-    for (ito= 0; ito < to->Nbr; ito++)
+    arrangement_key_type key;
+    arrangement_memo_entry_type *entry;
+
+    key.length = 0;
+    arrangement_key_append(&key,camp);
+    arrangement_key_append(&key,CapturesAllowed);
+    arrangement_key_append_list(&key,from,false);
+    arrangement_key_append_list(&key,to,false);
+
+    entry = find_arrangement(&key);
+    if (is_arrangement_remembered(entry,&key))
     {
-      pl[ito].Nbr= 0;
-      for (ifrom= 0; ifrom<from->Nbr; ifrom++)
+      Diff = entry->moves;
+      if (Diff != current_length)
+        *CapturesRequired = entry->captures_required;
+    }
+    else
+    {
+      for (ito= 0; ito < to->Nbr; ito++)
       {
-        PawnMovesFromTo(camp,from->sq[ifrom],
-                        to->sq[ito], &moves, &captures, CapturesAllowed);
-        if (moves < current_length)
+        pl[ito].Nbr= 0;
+        for (ifrom= 0; ifrom<from->Nbr; ifrom++)
         {
-          pl[ito].moves[pl[ito].Nbr]= moves;
-          pl[ito].captures[pl[ito].Nbr]= captures;
-          pl[ito].id[pl[ito].Nbr]= ifrom;
-          pl[ito].Nbr++;
+          PawnMovesFromTo(camp,from->sq[ifrom],
+                          to->sq[ito], &moves, &captures, CapturesAllowed);
+          if (moves < current_length)
+          {
+            pl[ito].moves[pl[ito].Nbr]= moves;
+            pl[ito].captures[pl[ito].Nbr]= captures;
+            pl[ito].id[pl[ito].Nbr]= ifrom;
+            pl[ito].Nbr++;
+          }
         }
       }
-    }
-
-    for (ifrom= 0; ifrom < from->Nbr; ifrom++)
-      taken[ifrom]= false;
 
-    /* determine minimal number of moves required */
-    Diff= ArrangeListedPieces(pl,
-                              to->Nbr, from->Nbr, taken, CapturesAllowed);
+      /* determine minimal number of moves required */
+      Diff= ArrangeListedPiecesWithin(pl,
+                                      to->Nbr, from->Nbr, CapturesAllowed);
 
-    if (Diff != current_length)
-    {
-      /* determine minimal number of captures required */
       captures= 0;
-      while (ArrangeListedPieces(pl, to->Nbr, from->Nbr, taken, captures)
-             == current_length)
-        captures++;
 
-      *CapturesRequired= captures;
-      TraceValue("%u",*CapturesRequired);
-      TraceEOL();
+      if (Diff != current_length)
+      {
+        /* determine minimal number of captures required; the fewest captures
+         * may require too many moves */
+        if (AssignListedPieces(pl, to->Nbr, from->Nbr, true, &moves, &captures))
+          while (moves>=current_length)
+          {
+            ++captures;
+            moves= ArrangeListedPiecesWithin(pl, to->Nbr, from->Nbr, captures);
+          }
+
+        *CapturesRequired= captures;
+        TraceValue("%u",*CapturesRequired);
+        TraceEOL();
+      }
+
+      entry->key = key;
+      entry->moves = Diff;
+      entry->captures_required = captures;
     }
   }
 
@@ -844,11 +1181,10 @@ static boolean FairyImpossible(void)
 
 static boolean Impossible(void)
 {
-  square const *bnp;
   stip_length_type moves_left[nr_sides] = { MovesLeft[White], MovesLeft[Black] };
   stip_length_type to_be_captured[nr_sides];
   stip_length_type captures_required[nr_sides];
-  square    sq;
+  square_set_type differing;
   unsigned int Nbr[nr_sides];
 
   TraceText("ProofImpossible\n");
@@ -935,19 +1271,12 @@ static boolean Impossible(void)
     return true;
   }
 
-  /* has a white pawn on the second rank moved or has it
-     been captured?
-  */
-  for (sq= square_a2; sq<=square_h2; sq+=dir_right)
-    if ((proofgames_target_position.board[sq]==Pawn && TSTFLAG(proofgames_target_position.spec[sq],White)) && !(get_walk_of_piece_on_square(sq)==Pawn && TSTFLAG(being_solved.spec[sq],White)))
-      return true;
-
-  /* has a black pawn on the seventh rank moved or has it
-     been captured?
+  /* has a white pawn on the second rank or a black pawn on the seventh rank
+     moved or has it been captured?
   */
-  for (sq= square_a7; sq<=square_h7; sq+=dir_right)
-    if ((proofgames_target_position.board[sq]==Pawn && TSTFLAG(proofgames_target_position.spec[sq],Black)) && !(get_walk_of_piece_on_square(sq)==Pawn && TSTFLAG(being_solved.spec[sq],Black)))
-      return true;
+  if ((UnmovedPawns[White] & ~get_squares_occupied_by_walk(White,Pawn))!=0
+      || (UnmovedPawns[Black] & ~get_squares_occupied_by_walk(Black,Pawn))!=0)
+    return true;
 
   {
     stip_length_type const white_king_moves_needed = KingMovesNeeded(White);
@@ -986,63 +1315,79 @@ static boolean Impossible(void)
   PiecesToBeArranged[White].Nbr = 0;
   PawnsToBeArranged[Black].Nbr = 0;
   PiecesToBeArranged[Black].Nbr= 0;
+  PawnsOnBoard[White].Nbr = 0;
+  PawnsOnBoard[Black].Nbr = 0;
+
+  {
+    square_set_type pawns = get_squares_occupied_by_walk(White,Pawn);
+    while (pawns!=0)
+      PawnsOnBoard[White].sq[PawnsOnBoard[White].Nbr++] = square_set_pop_first(&pawns);
+  }
 
-  for (bnp= boardnum; *bnp; bnp++)
   {
-    piece_walk_type const p1 = proofgames_target_position.board[*bnp];
-    piece_walk_type const p2 = get_walk_of_piece_on_square(*bnp);
-    Side const side_target = TSTFLAG(proofgames_target_position.spec[*bnp],White) ? White : Black;
-    Side const side_current = TSTFLAG(being_solved.spec[*bnp],White) ? White : Black;
+    square_set_type pawns = get_squares_occupied_by_walk(Black,Pawn);
+    while (pawns!=0)
+      PawnsOnBoard[Black].sq[PawnsOnBoard[Black].Nbr++] = square_set_pop_first(&pawns);
+  }
 
-    if (p1!=p2 || side_target!=side_current)
+  /* only the pieces that aren't on their target squares need to be
+   * arranged */
+  differing = (proof_squares_differing_from_target()
+               | (being_solved.non_empty^proofgames_target_position.non_empty));
+  while (differing!=0)
+  {
+    square const sq = square_set_pop_first(&differing);
+    piece_walk_type const p1 = proofgames_target_position.board[sq];
+    piece_walk_type const p2 = get_walk_of_piece_on_square(sq);
+    Side const side_target = TSTFLAG(proofgames_target_position.spec[sq],White) ? White : Black;
+    Side const side_current = TSTFLAG(being_solved.spec[sq],White) ? White : Black;
+
+    switch (p1)
     {
-      switch (p1)
-      {
-        case Empty:
-        case King:
-          break;
-
-        case Pawn:
-          ProofPawns[side_target].sq[ProofPawns[side_target].Nbr]= *bnp;
-          ProofPawns[side_target].Nbr++;
-          ProofOfficers[side_target].sq[ProofOfficers[side_target].Nbr]= *bnp;
-          ProofOfficers[side_target].Nbr++;
-          break;
-
-        default:
-          ProofOfficers[side_target].sq[ProofOfficers[side_target].Nbr]= *bnp;
-          ProofOfficers[side_target].Nbr++;
-          break;
-      }
+      case Empty:
+      case King:
+        break;
+
+      case Pawn:
+        ProofPawns[side_target].sq[ProofPawns[side_target].Nbr]= sq;
+        ProofPawns[side_target].Nbr++;
+        ProofOfficers[side_target].sq[ProofOfficers[side_target].Nbr]= sq;
+        ProofOfficers[side_target].Nbr++;
+        break;
+
+      default:
+        ProofOfficers[side_target].sq[ProofOfficers[side_target].Nbr]= sq;
+        ProofOfficers[side_target].Nbr++;
+        break;
+    }
 
-      switch (p2)
-      {
-        case Empty:
-        case King:
-          break;
+    switch (p2)
+    {
+      case Empty:
+      case King:
+        break;
 
-        case Pawn:
-          PawnsToBeArranged[side_current].sq[PawnsToBeArranged[side_current].Nbr++] = *bnp;
-          PiecesToBeArranged[side_current].sq[PiecesToBeArranged[side_current].Nbr++] = *bnp;
-          break;
+      case Pawn:
+        PawnsToBeArranged[side_current].sq[PawnsToBeArranged[side_current].Nbr++] = sq;
+        PiecesToBeArranged[side_current].sq[PiecesToBeArranged[side_current].Nbr++] = sq;
+        break;
 
-        default:
-          if (side_current==White)
-          {
-            if (!(CapturedQueenBishop[White] && *bnp == square_c1 && p2 == Bishop)
-                && !(CapturedKingBishop[White] && *bnp == square_f1 && p2 == Bishop)
-                && !(CapturedQueen[White] && *bnp == square_d1 && p2 == Queen))
-              PiecesToBeArranged[side_current].sq[PiecesToBeArranged[side_current].Nbr++] = *bnp;
-          }
-          else
-          {
-            if (!(CapturedQueenBishop[Black] && *bnp == square_c8 && p2 == Bishop)
-                && !(CapturedKingBishop[Black] && *bnp == square_f8 && p2 == Bishop)
-                && !(CapturedQueen[Black] && *bnp == square_d8 && p2 == Queen))
-              PiecesToBeArranged[side_current].sq[PiecesToBeArranged[side_current].Nbr++] = *bnp;
-          }
-          break;
-      }
+      default:
+        if (side_current==White)
+        {
+          if (!(CapturedQueenBishop[White] && sq == square_c1 && p2 == Bishop)
+              && !(CapturedKingBishop[White] && sq == square_f1 && p2 == Bishop)
+              && !(CapturedQueen[White] && sq == square_d1 && p2 == Queen))
+            PiecesToBeArranged[side_current].sq[PiecesToBeArranged[side_current].Nbr++] = sq;
+        }
+        else
+        {
+          if (!(CapturedQueenBishop[Black] && sq == square_c8 && p2 == Bishop)
+              && !(CapturedKingBishop[Black] && sq == square_f8 && p2 == Bishop)
+              && !(CapturedQueen[Black] && sq == square_d8 && p2 == Queen))
+            PiecesToBeArranged[side_current].sq[PiecesToBeArranged[side_current].Nbr++] = sq;
+        }
+        break;
     }
   }
 
@@ -1297,6 +1642,16 @@ static void InitialiseIntelligentSide(Side side)
       ProofNbrPieces[side] += proofgames_target_position.number_of_pieces[side][i];
   }
 
+  UnmovedPawns[side] = 0;
+
+  {
+    square const square_pawn_base = side==White ? square_a2 : square_a7;
+    square sq;
+    for (sq = square_pawn_base; sq<square_pawn_base+nr_files_on_board; ++sq)
+      if (proofgames_target_position.board[sq]==Pawn && TSTFLAG(proofgames_target_position.spec[sq],side))
+        UnmovedPawns[side] |= square_set_element(sq);
+  }
+
   if (!ProofFairy)
   {
     numvec const dir_forward = side==White ? dir_up : dir_down;
@@ -1361,12 +1716,39 @@ static void InitialiseIntelligentSide(Side side)
   TraceFunctionResultEnd();
 }
 
+static void InitialiseSquaresBetween(void)
+{
+  unsigned int i;
+
+  for (i = 0; i!=nr_squares_on_board; ++i)
+  {
+    unsigned int j;
+    for (j = 0; j!=nr_squares_on_board; ++j)
+    {
+      square const from = boardnum[i];
+      square const to = boardnum[j];
+      numvec const dir = from==to ? 0 : CheckDir[Queen][to-from];
+
+      SquaresBetween[i][j] = 0;
+
+      if (dir!=0)
+      {
+        square sq;
+        for (sq = from+dir; sq!=to; sq += dir)
+          SquaresBetween[i][j] |= square_set_element(sq);
+      }
+    }
+  }
+}
+
 static void InitialiseIntelligent(void)
 {
   TraceFunctionEntry(__func__);
   TraceFunctionParamListEnd();
 
   current_length = MOVE_HAS_SOLVED_LENGTH();
+  forget_arrangements();
+  InitialiseSquaresBetween();
 
   InitialiseIntelligentSide(White);
   InitialiseIntelligentSide(Black);
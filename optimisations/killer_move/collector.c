@@ -4,6 +4,7 @@
 #include "stipulation/branch.h"
 #include "stipulation/battle_play/branch.h"
 #include "optimisations/killer_move/killer_move.h"
+#include "optimisations/killer_move/history.h"
 #include "solving/pipe.h"
 #include "debugging/trace.h"
 
@@ -66,7 +67,10 @@ void killer_defense_collector_solve(slice_index si)
   pipe_solve_delegate(si);
 
   if (solve_result>MOVE_HAS_SOLVED_LENGTH())
+  {
     remember_killer_move();
+    move_history_remember();
+  }
 
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
@@ -112,7 +116,10 @@ void killer_attack_collector_solve(slice_index si)
   pipe_solve_delegate(si);
 
   if (move_has_solved())
+  {
     remember_killer_move();
+    move_history_remember();
+  }
 
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
@@ -0,0 +1,175 @@
+#include "optimisations/killer_move/history.h"
+#include "solving/move_generator.h"
+#include "solving/move_effect_journal.h"
+#include "solving/machinery/slack_length.h"
+#include "solving/ply.h"
+#include "stipulation/stipulation.h"
+#include "stipulation/pipe.h"
+#include "solving/has_solution_type.h"
+#include "position/position.h"
+#include "solving/pipe.h"
+#include "debugging/trace.h"
+
+#include "debugging/assert.h"
+#include <limits.h>
+#include <string.h>
+
+enum
+{
+  /* prime; moves that share an entry share their score */
+  history_size = 65521,
+
+  /* scores are halved before they can overflow */
+  max_score = UINT_MAX/2
+};
+
+static unsigned int scores[nr_sides][history_size];
+
+/* scores of the moves of the ply being priorised, by position in
+ * move_generation_stack */
+static unsigned int move_scores[toppile+1];
+
+static unsigned int find_entry(piece_walk_type walk,
+                               square departure,
+                               square arrival)
+{
+  return ((walk*(maxsquare+5)+departure)*(maxsquare+5)+arrival) % history_size;
+}
+
+/* Forget the scores of all moves
+ */
+void reset_move_history(void)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  memset(scores,0,sizeof scores);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+static void age_scores(Side side)
+{
+  unsigned int i;
+
+  for (i = 0; i!=history_size; ++i)
+    scores[side][i] /= 2;
+}
+
+/* Remember that the move just played has solved or refuted
+ */
+void move_history_remember(void)
+{
+  move_effect_journal_index_type const movement = move_effect_journal_base[nbply]+move_effect_journal_index_offset_movement;
+  piece_walk_type const walk = move_effect_journal[movement].u.piece_movement.moving;
+  move_generation_elmt const * const move = &move_generation_stack[CURRMOVE_OF_PLY(nbply)];
+  Side const side = trait[nbply];
+  unsigned int const depth = (solve_nr_remaining>slack_length
+                              ? solve_nr_remaining-slack_length
+                              : 1);
+  unsigned int const entry = find_entry(walk,move->departure,move->arrival);
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  TraceWalk(walk);
+  TraceSquare(move->departure);
+  TraceSquare(move->arrival);
+  TraceValue("%u",depth);
+  TraceEOL();
+
+  /* refutations and solutions found with more half-moves remaining are
+   * more likely to work elsewhere */
+  if (scores[side][entry]>max_score-depth*depth)
+    age_scores(side);
+
+  scores[side][entry] += depth*depth;
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Allocate a STHistoryMovePrioriser slice.
+ * @return index of allocated slice
+ */
+slice_index alloc_history_move_prioriser_slice(void)
+{
+  slice_index result;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  result = alloc_pipe(STHistoryMovePrioriser);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResult("%u",result);
+  TraceFunctionResultEnd();
+  return result;
+}
+
+/* Sort the moves of the current ply so that the moves with the highest scores
+ * are played first. Moves with equal scores keep their order, i.e. nothing
+ * changes as long as no move has a score.
+ * @param side side to be moved
+ */
+static void sort_moves(Side side)
+{
+  numecoup const base = MOVEBASE_OF_PLY(nbply)+1;
+  numecoup const top = CURRMOVE_OF_PLY(nbply);
+  boolean is_any_move_scored = false;
+  numecoup i;
+
+  for (i = base; i<=top; ++i)
+  {
+    move_generation_elmt const * const move = &move_generation_stack[i];
+    piece_walk_type const walk = get_walk_of_piece_on_square(move->departure);
+    move_scores[i] = scores[side][find_entry(walk,move->departure,move->arrival)];
+    if (move_scores[i]>0)
+      is_any_move_scored = true;
+  }
+
+  /* the moves are played from the top of the stack downwards */
+  if (is_any_move_scored)
+    for (i = base+1; i<=top; ++i)
+    {
+      move_generation_elmt const move = move_generation_stack[i];
+      unsigned int const score = move_scores[i];
+      numecoup j;
+
+      for (j = i; j>base && move_scores[j-1]>score; --j)
+      {
+        move_generation_stack[j] = move_generation_stack[j-1];
+        move_scores[j] = move_scores[j-1];
+      }
+
+      move_generation_stack[j] = move;
+      move_scores[j] = score;
+    }
+}
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void history_move_prioriser_solve(slice_index si)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  sort_moves(trait[nbply]);
+  pipe_solve_delegate(si);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
@@ -0,0 +1,42 @@
+#if !defined(OPTIMISATION_KILLER_MOVE_HISTORY_H)
+#define OPTIMISATION_KILLER_MOVE_HISTORY_H
+
+#include "solving/machinery/solve.h"
+
+/* This module implements the history heuristic: moves (identified by the
+ * moving walk, their departure and their arrival square) that have solved
+ * or refuted in some position get a score that grows with the number of
+ * half-moves that were remaining. STHistoryMovePrioriser slices try the moves
+ * with higher scores first. Unlike a killer move, the score of a move survives
+ * when the move is superseded in its ply, and it is shared between plies.
+ */
+
+/* Forget the scores of all moves
+ */
+void reset_move_history(void);
+
+/* Remember that the move just played has solved or refuted
+ */
+void move_history_remember(void);
+
+/* Allocate a STHistoryMovePrioriser slice.
+ * @return index of allocated slice
+ */
+slice_index alloc_history_move_prioriser_slice(void);
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void history_move_prioriser_solve(slice_index si);
+
+#endif
@@ -4,6 +4,7 @@
 #include "solving/fork_on_remaining.h"
 #include "solving/move_generator.h"
 #include "optimisations/killer_move/prioriser.h"
+#include "optimisations/killer_move/history.h"
 #include "optimisations/killer_move/collector.h"
 #include "optimisations/killer_move/final_defense_move.h"
 #include "debugging/trace.h"
@@ -239,6 +240,7 @@ static void substitute_killermove_machinery(slice_index si,
     {
       slice_index const prototypes[] =
       {
+          alloc_history_move_prioriser_slice(),
           alloc_killer_move_prioriser_slice(),
           alloc_killer_attack_collector_slice()
       };
@@ -249,6 +251,7 @@ static void substitute_killermove_machinery(slice_index si,
     {
       slice_index const prototypes[] =
       {
+          alloc_history_move_prioriser_slice(),
           alloc_killer_move_prioriser_slice(),
           alloc_killer_defense_collector_slice()
       };
@@ -347,6 +350,8 @@ static void optimise_move_generators(slice_index si)
     }
   }
 
+  reset_move_history();
+
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
 }
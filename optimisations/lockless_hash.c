@@ -0,0 +1,417 @@
+#include "optimisations/lockless_hash.h"
+#include "platform/maxmem.h"
+#include "debugging/trace.h"
+#include "debugging/assert.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef unsigned long long word_type;
+
+typedef struct
+{
+    word_type volatile check; /* key ^ data */
+    word_type volatile data;  /* generation, value, data */
+} entry_type;
+
+typedef struct
+{
+    entry_type entries[lockless_hash_bucket_size];
+} bucket_type;
+
+/* The first bucket-sized block of the memory holds the header. The state of
+ * aging is shared by the processes, too. */
+typedef struct
+{
+    char magic[8];
+    word_type fingerprint;
+    word_type nr_buckets;
+    word_type volatile nr_stores;
+    unsigned int volatile generation;
+} header_type;
+
+static char const magic[sizeof ((header_type *)0)->magic] = "pyhash1";
+
+static void *memory_allocated;
+static header_type *header;
+static bucket_type *table;
+static size_t nr_buckets;
+static boolean is_mapped_from_file;
+
+/* leaves room for the header */
+static size_t const max_nr_buckets = ((size_t)-1)/2/sizeof(bucket_type)-1;
+
+static lockless_hash_statistics_type statistics;
+
+enum
+{
+  data_bits = 32,
+  value_bits = 24,
+  generation_offset = data_bits+value_bits,
+
+  max_value = (1u<<value_bits)-1,
+  max_generation = (1u<<(64-generation_offset))-1,
+
+  /* the last entry of each bucket is always replaced */
+  nr_preferred_entries = lockless_hash_bucket_size-1
+};
+
+static word_type const data_mask = 0xffffffffu;
+
+static unsigned int generation_of(word_type entry_data)
+{
+  return (unsigned int)(entry_data>>generation_offset);
+}
+
+static unsigned int value_of(word_type entry_data)
+{
+  return (unsigned int)(entry_data>>data_bits) & max_value;
+}
+
+/* Start a new generation if as many positions have been stored in the
+ * current one as the table has entries
+ */
+static void age(void)
+{
+  ++header->nr_stores;
+  if (header->nr_stores>=nr_buckets*lockless_hash_bucket_size)
+  {
+    header->nr_stores = 0;
+    /* 0 is the generation of the unused entries */
+    header->generation = header->generation==max_generation ? 1 : header->generation+1;
+  }
+}
+
+/* Compute the key of a position
+ * @param encoding encoding of the position
+ * @param length number of bytes of the encoding
+ * @return key; never 0
+ */
+lockless_hash_key_type lockless_hash_key(unsigned char const *encoding,
+                                         unsigned int length)
+{
+  /* FNV-1a */
+  lockless_hash_key_type result = 14695981039346656037ull;
+  unsigned int i;
+
+  for (i = 0; i!=length; ++i)
+  {
+    result ^= encoding[i];
+    result *= 1099511628211ull;
+  }
+
+  /* 0 is the key of the unused entries */
+  return result==0 ? 1 : result;
+}
+
+/* Determine the number of buckets fitting into an amount of memory
+ * @param nr_kilos number of kilo-bytes
+ * @return number of buckets; a power of 2 so that the bucket can be
+ *         determined by masking the key
+ */
+static size_t nr_buckets_fitting(unsigned long nr_kilos)
+{
+  size_t const one_kilo = 1<<10;
+  size_t result = 1;
+
+  while (result<max_nr_buckets
+         && 2*result*sizeof *table<=nr_kilos*one_kilo)
+    result *= 2;
+
+  return result;
+}
+
+/* Let header and table point into newly allocated memory
+ * @param memory address of the memory; holds the header, then the buckets
+ * @note the buckets fill one cache line each if memory is aligned to the size
+ *       of a bucket
+ */
+static void attach(void *memory)
+{
+  assert(sizeof *header<=sizeof *table);
+  header = memory;
+  table = (bucket_type *)memory+1;
+  memset(&statistics,0,sizeof statistics);
+}
+
+/* Determine the first address in a block of memory that is aligned to the
+ * size of a bucket
+ * @param memory address of the block
+ * @return aligned address; at most one bucket beyond memory
+ */
+static void *align_to_bucket(void *memory)
+{
+  size_t const misalignment = (size_t)memory % sizeof *table;
+  return misalignment==0 ? memory : (char *)memory+sizeof *table-misalignment;
+}
+
+/* Write a header for an empty table
+ * @param fingerprint identifies what the table is used for
+ */
+static void init_header(lockless_hash_fingerprint_type fingerprint)
+{
+  memcpy(header->magic,magic,sizeof magic);
+  header->fingerprint = fingerprint;
+  header->nr_buckets = nr_buckets;
+  header->nr_stores = 0;
+  header->generation = 1;
+}
+
+/* Determine the number of kilo-bytes of the allocated table
+ * @return number of kilo-bytes
+ */
+static unsigned long allocated_kilos(void)
+{
+  size_t const one_kilo = 1<<10;
+  return table==0 ? 0 : (unsigned long)(nr_buckets*sizeof *table/one_kilo);
+}
+
+/* Allocate the table. If the requested amount of memory isn't available,
+ * reduce the amount until allocation succeeds.
+ * The table is shared with worker processes started afterwards.
+ * @param nr_kilos number of kilo-bytes to allocate
+ * @return number of kilo-bytes actually allocated; 0 if allocation failed
+ */
+unsigned long lockless_hash_allocate(unsigned long nr_kilos)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%lu",nr_kilos);
+  TraceFunctionParamListEnd();
+
+  assert(table==0);
+
+  nr_buckets = nr_buckets_fitting(nr_kilos);
+
+  while (true)
+  {
+    /* one additional bucket leaves room for aligning the buckets */
+    void * const memory = platform_allocate_table_memory((nr_buckets+2)*sizeof *table,
+                                                         true);
+    if (memory!=0)
+    {
+      memory_allocated = memory;
+      attach(align_to_bucket(memory));
+      is_mapped_from_file = false;
+      init_header(0);
+      break;
+    }
+    else if (nr_buckets==1)
+      break;
+    else
+      nr_buckets /= 2;
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResult("%lu",allocated_kilos());
+  TraceFunctionResultEnd();
+  return allocated_kilos();
+}
+
+/* Read the header of a table file
+ * @param path path of the file
+ * @param result where to write the header to
+ * @return true iff the file exists and starts with a header
+ */
+static boolean read_header(char const *path, header_type *result)
+{
+  boolean found = false;
+  FILE * const file = fopen(path,"rb");
+
+  if (file!=0)
+  {
+    found = (fread(result,sizeof *result,1,file)==1
+             && memcmp(result->magic,magic,sizeof magic)==0);
+    fclose(file);
+  }
+
+  return found;
+}
+
+/* Allocate the table in a file, so that its contents survive the process.
+ * If the file holds a table with the same fingerprint, the table is
+ * taken over with its contents and size; otherwise, the file is
+ * overwritten with an empty table.
+ * The table is shared with worker processes started afterwards.
+ * @param path path of the file
+ * @param fingerprint identifies what the table is used for
+ * @param nr_kilos number of kilo-bytes to allocate for a new table
+ * @return number of kilo-bytes of the table; 0 if the file couldn't be used
+ */
+unsigned long lockless_hash_allocate_in_file(char const *path,
+                                             lockless_hash_fingerprint_type fingerprint,
+                                             unsigned long nr_kilos)
+{
+  header_type found;
+  boolean const is_taken_over = (read_header(path,&found)
+                                 && found.fingerprint==fingerprint
+                                 && found.nr_buckets!=0
+                                 && (found.nr_buckets&(found.nr_buckets-1))==0
+                                 && found.nr_buckets<=max_nr_buckets);
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%s",path);
+  TraceFunctionParam("%llx",fingerprint);
+  TraceFunctionParam("%lu",nr_kilos);
+  TraceFunctionParamListEnd();
+
+  assert(table==0);
+
+  nr_buckets = is_taken_over ? (size_t)found.nr_buckets : nr_buckets_fitting(nr_kilos);
+
+  {
+    void * const memory = platform_map_table_file(path,
+                                                  (nr_buckets+1)*sizeof *table,
+                                                  is_taken_over);
+    if (memory!=0)
+    {
+      /* mapped memory is aligned to pages */
+      memory_allocated = memory;
+      attach(memory);
+      is_mapped_from_file = true;
+      if (!is_taken_over)
+        init_header(fingerprint);
+    }
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResult("%lu",allocated_kilos());
+  TraceFunctionResultEnd();
+  return allocated_kilos();
+}
+
+/* Free the table; a table allocated in a file is written to the file
+ */
+void lockless_hash_free(void)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  if (table!=0)
+  {
+    if (is_mapped_from_file)
+      platform_unmap_table_file(memory_allocated,(nr_buckets+1)*sizeof *table);
+    else
+      platform_free_table_memory(memory_allocated,(nr_buckets+2)*sizeof *table);
+    memory_allocated = 0;
+    header = 0;
+    table = 0;
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Look up a position
+ * @param key key of the position
+ * @param data where to write the data stored for the position
+ * @return true iff the position was found
+ */
+boolean lockless_hash_lookup(lockless_hash_key_type key, unsigned int *data)
+{
+  bucket_type const * const bucket = &table[key&(nr_buckets-1)];
+  unsigned int i;
+
+  assert(table!=0);
+
+  ++statistics.nr_lookups;
+
+  for (i = 0; i!=lockless_hash_bucket_size; ++i)
+  {
+    /* another process may be writing the entry while we are reading it */
+    word_type const entry_data = bucket->entries[i].data;
+    word_type const entry_check = bucket->entries[i].check;
+    if ((entry_check^entry_data)==key)
+    {
+      *data = (unsigned int)(entry_data&data_mask);
+      ++statistics.nr_hits;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/* Store the data of a position
+ * @param key key of the position
+ * @param data data to be stored
+ * @param value how much the data are worth; determines which entry of a
+ *              bucket is replaced
+ */
+void lockless_hash_store(lockless_hash_key_type key,
+                         unsigned int data,
+                         unsigned int value)
+{
+  bucket_type * const bucket = &table[key&(nr_buckets-1)];
+  unsigned int const generation = header->generation;
+  unsigned int const new_value = value>max_value ? max_value : value;
+  word_type const new_data = (((word_type)generation<<generation_offset)
+                              | ((word_type)new_value<<data_bits)
+                              | data);
+  unsigned int victim = lockless_hash_bucket_size;
+  boolean is_victim_stale = false;
+  unsigned int victim_value = 0;
+  unsigned int i;
+
+  assert(table!=0);
+
+  ++statistics.nr_stores;
+
+  for (i = 0; i!=lockless_hash_bucket_size; ++i)
+  {
+    word_type const entry_data = bucket->entries[i].data;
+    word_type const entry_check = bucket->entries[i].check;
+    if ((entry_check^entry_data)==key)
+    {
+      /* the position is already in the table */
+      bucket->entries[i].check = key^new_data;
+      bucket->entries[i].data = new_data;
+      return;
+    }
+  }
+
+  for (i = 0; i!=nr_preferred_entries; ++i)
+  {
+    word_type const entry_data = bucket->entries[i].data;
+    /* unused entries are stale and worth nothing */
+    boolean const is_stale = generation_of(entry_data)!=generation;
+    unsigned int const entry_value = value_of(entry_data);
+    if (victim==lockless_hash_bucket_size
+        || (is_stale && !is_victim_stale)
+        || (is_stale==is_victim_stale && entry_value<victim_value))
+    {
+      victim = i;
+      is_victim_stale = is_stale;
+      victim_value = entry_value;
+    }
+  }
+
+  if (!is_victim_stale && victim_value>new_value)
+  {
+    /* the preferred entries are worth more than the new position */
+    victim = nr_preferred_entries;
+    is_victim_stale = generation_of(bucket->entries[victim].data)!=generation;
+  }
+
+  if (bucket->entries[victim].data!=0)
+  {
+    ++statistics.nr_replacements;
+    if (is_victim_stale)
+      ++statistics.nr_stale_replacements;
+  }
+
+  bucket->entries[victim].check = key^new_data;
+  bucket->entries[victim].data = new_data;
+
+  age();
+}
+
+/* Retrieve the statistics of the table; lookups and stores are counted per
+ * process
+ * @param result where to write the statistics to
+ */
+void lockless_hash_get_statistics(lockless_hash_statistics_type *result)
+{
+  *result = statistics;
+  result->generation = header==0 ? 0 : header->generation;
+}
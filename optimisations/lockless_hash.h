@@ -0,0 +1,107 @@
+#if !defined(OPTIMISATIONS_LOCKLESS_HASH_H)
+#define OPTIMISATIONS_LOCKLESS_HASH_H
+
+#include "utilities/boolean.h"
+
+/* Fixed size hash table that can be shared by several processes without
+ * locking.
+ *
+ * The table consists of buckets of lockless_hash_bucket_size entries; a
+ * bucket fills one cache line. A position is identified by a 64 bit key
+ * computed from its encoding; the encoding itself isn't stored. Each entry
+ * consists of two words: the data and the data xor'ed with the key. A reader
+ * only accepts an entry if the two words match the key; if two processes
+ * write the same entry concurrently, the entry is torn and simply becomes
+ * invisible.
+ *
+ * The first entries of a bucket are reserved for the positions that are worth
+ * the most; a new position replaces the one worth the least of them, unless
+ * that one is still worth more than the new one. In that case, the new
+ * position is written to the last entry of the bucket, whose contents are
+ * always replaced.
+ * Positions age: the table is in a new generation each time that as many
+ * positions have been stored as the table has entries. Positions stored in an
+ * older generation are replaced first, regardless of their worth.
+ *
+ * The table may be held in a file, together with a fingerprint of what it is
+ * used for; a later process can then take over the table with its contents.
+ */
+
+enum
+{
+  lockless_hash_bucket_size = 4
+};
+
+typedef unsigned long long lockless_hash_key_type;
+
+/* identifies what a table is used for; see lockless_hash_allocate_in_file() */
+typedef unsigned long long lockless_hash_fingerprint_type;
+
+typedef struct
+{
+    unsigned long nr_lookups;
+    unsigned long nr_hits;
+    unsigned long nr_stores;
+    unsigned long nr_replacements;       /* stores that evicted a position */
+    unsigned long nr_stale_replacements; /* ... stored in an older generation */
+    unsigned int generation;
+} lockless_hash_statistics_type;
+
+/* Compute the key of a position
+ * @param encoding encoding of the position
+ * @param length number of bytes of the encoding
+ * @return key; never 0
+ */
+lockless_hash_key_type lockless_hash_key(unsigned char const *encoding,
+                                         unsigned int length);
+
+/* Allocate the table. If the requested amount of memory isn't available,
+ * reduce the amount until allocation succeeds.
+ * The table is shared with worker processes started afterwards.
+ * @param nr_kilos number of kilo-bytes to allocate
+ * @return number of kilo-bytes actually allocated; 0 if allocation failed
+ */
+unsigned long lockless_hash_allocate(unsigned long nr_kilos);
+
+/* Allocate the table in a file, so that its contents survive the process.
+ * If the file holds a table with the same fingerprint, the table is
+ * taken over with its contents and size; otherwise, the file is
+ * overwritten with an empty table.
+ * The table is shared with worker processes started afterwards.
+ * @param path path of the file
+ * @param fingerprint identifies what the table is used for
+ * @param nr_kilos number of kilo-bytes to allocate for a new table
+ * @return number of kilo-bytes of the table; 0 if the file couldn't be used
+ */
+unsigned long lockless_hash_allocate_in_file(char const *path,
+                                             lockless_hash_fingerprint_type fingerprint,
+                                             unsigned long nr_kilos);
+
+/* Free the table; a table allocated in a file is written to the file
+ */
+void lockless_hash_free(void);
+
+/* Look up a position
+ * @param key key of the position
+ * @param data where to write the data stored for the position
+ * @return true iff the position was found
+ */
+boolean lockless_hash_lookup(lockless_hash_key_type key, unsigned int *data);
+
+/* Store the data of a position
+ * @param key key of the position
+ * @param data data to be stored
+ * @param value how much the data are worth; determines which entry of a
+ *              bucket is replaced
+ */
+void lockless_hash_store(lockless_hash_key_type key,
+                         unsigned int data,
+                         unsigned int value);
+
+/* Retrieve the statistics of the table; lookups and stores are counted per
+ * process
+ * @param result where to write the statistics to
+ */
+void lockless_hash_get_statistics(lockless_hash_statistics_type *result);
+
+#endif
@@ -0,0 +1,176 @@
+#include "optimisations/observation_cache.h"
+#include "conditions/conditions.h"
+#include "pieces/walks/pawns/en_passant.h"
+#include "position/position.h"
+#include "solving/move_generator.h"
+#include "solving/ply.h"
+#include "debugging/trace.h"
+
+#include "debugging/assert.h"
+#include <string.h>
+
+enum
+{
+  cache_size = 1<<16
+};
+
+static struct
+{
+    position_hash_key_type key;
+    boolean is_observed;
+} cache[cache_size];
+
+static boolean is_enabled;
+
+/* conditions whose observation tests only depend on the board */
+static Cond const cacheable_conditions[] =
+{
+  madras,
+  isardam,
+  patrouille,
+  ultrapatrouille,
+  beamten
+};
+
+enum
+{
+  nr_cacheable_conditions = (sizeof cacheable_conditions
+                             / sizeof cacheable_conditions[0])
+};
+
+static boolean is_condition_cacheable(Cond cond)
+{
+  unsigned int i;
+
+  for (i = 0; i!=nr_cacheable_conditions; ++i)
+    if (cacheable_conditions[i]==cond)
+      return true;
+
+  return false;
+}
+
+/* Forget all answers and decide whether the conditions of the problem allow
+ * answers to be remembered
+ */
+void observation_cache_initialise(void)
+{
+  Flags const cacheable_flags = (BIT(piece_flag_white)|BIT(piece_flag_black)
+                                 |BIT(Royal)
+                                 |BIT(Patrol)|BIT(Beamtet));
+  boolean is_cache_useful = TSTFLAG(some_pieces_flags,Patrol) || TSTFLAG(some_pieces_flags,Beamtet);
+  unsigned int i;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  is_enabled = (some_pieces_flags&~cacheable_flags)==0;
+
+  for (i = 0; i!=CondCount; ++i)
+    if (CondFlag[i])
+    {
+      if (is_condition_cacheable(i))
+        is_cache_useful = true;
+      else
+        is_enabled = false;
+    }
+
+  for (i = 0; i!=ExtraCondCount; ++i)
+    if (ExtraCondFlag[i])
+      is_enabled = false;
+
+  is_enabled = is_enabled && is_cache_useful;
+
+  if (is_enabled)
+    memset(cache,0,sizeof cache);
+
+  TraceValue("%u",is_enabled);
+  TraceEOL();
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+static position_hash_key_type calc_key(piece_walk_type walk,
+                                       validator_id evaluate)
+{
+  ply const parent = parent_ply[nbply];
+  square const sq_target = move_generation_stack[CURRMOVE_OF_PLY(nbply)].capture;
+  position_hash_key_type result = mix_hash_key(((position_hash_key_type)walk<<40)
+                                               ^ ((position_hash_key_type)evaluate<<16)
+                                               ^ ((position_hash_key_type)sq_target<<2)
+                                               ^ (trait[nbply]<<1)
+                                               ^ (trait[parent]==trait[nbply]));
+
+  /* pawns may observe by en passant capture */
+  if (parent>ply_nil)
+  {
+    unsigned int i;
+    for (i = en_passant_top[parent-1]+1; i<=en_passant_top[parent]; ++i)
+      result ^= mix_hash_key(((position_hash_key_type)en_passant_multistep_over[i]<<8)|0xff);
+  }
+
+  return being_solved.hash_key^result;
+}
+
+/* Look up whether the target square of the current ply is observed by the side
+ * at the move in the current ply
+ * @param walk walk of the observers; Empty if it isn't restricted
+ * @param evaluate identifies the set of restrictions imposed on the observation
+ * @param is_observed set to the answer if it is known
+ * @return true iff the answer is known
+ */
+boolean observation_cache_lookup(piece_walk_type walk,
+                                 validator_id evaluate,
+                                 boolean *is_observed)
+{
+  boolean result = false;
+
+  TraceFunctionEntry(__func__);
+  TraceWalk(walk);
+  TraceFunctionParamListEnd();
+
+  if (is_enabled)
+  {
+    position_hash_key_type const key = calc_key(walk,evaluate);
+    unsigned int const index = (unsigned int)(key % cache_size);
+
+    /* 0 marks an unused entry */
+    if (key!=0 && cache[index].key==key)
+    {
+      *is_observed = cache[index].is_observed;
+      result = true;
+    }
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResult("%u",result);
+  TraceFunctionResultEnd();
+  return result;
+}
+
+/* Remember whether the target square of the current ply is observed by the side
+ * at the move in the current ply
+ * @param walk walk of the observers; Empty if it isn't restricted
+ * @param evaluate identifies the set of restrictions imposed on the observation
+ * @param is_observed the answer
+ */
+void observation_cache_remember(piece_walk_type walk,
+                                validator_id evaluate,
+                                boolean is_observed)
+{
+  TraceFunctionEntry(__func__);
+  TraceWalk(walk);
+  TraceFunctionParam("%u",is_observed);
+  TraceFunctionParamListEnd();
+
+  if (is_enabled)
+  {
+    position_hash_key_type const key = calc_key(walk,evaluate);
+    unsigned int const index = (unsigned int)(key % cache_size);
+    cache[index].key = key;
+    cache[index].is_observed = is_observed;
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
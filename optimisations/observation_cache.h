@@ -0,0 +1,47 @@
+#if !defined(OPTIMISATIONS_OBSERVATION_CACHE_H)
+#define OPTIMISATIONS_OBSERVATION_CACHE_H
+
+/* Conditions such as Madrasi, Patrol and Beamten ask whether a piece is
+ * observed for every move generated and every observation validated, and
+ * they tend to ask the same question about the same position many times.
+ * This module remembers the answers.
+ *
+ * An answer is identified by the key of the board (which the move effect
+ * journal keeps up to date while moves are played and taken back), the
+ * en passant squares of the last move, the observing side, the observed
+ * square, the walk of the observers and the validator. The answers are only
+ * remembered if the conditions and piece attributes of the problem guarantee
+ * that nothing else influences them.
+ */
+
+#include "solving/observation.h"
+#include "pieces/pieces.h"
+#include "utilities/boolean.h"
+
+/* Forget all answers and decide whether the conditions of the problem allow
+ * answers to be remembered
+ */
+void observation_cache_initialise(void);
+
+/* Look up whether the target square of the current ply is observed by the side
+ * at the move in the current ply
+ * @param walk walk of the observers; Empty if it isn't restricted
+ * @param evaluate identifies the set of restrictions imposed on the observation
+ * @param is_observed set to the answer if it is known
+ * @return true iff the answer is known
+ */
+boolean observation_cache_lookup(piece_walk_type walk,
+                                 validator_id evaluate,
+                                 boolean *is_observed);
+
+/* Remember whether the target square of the current ply is observed by the side
+ * at the move in the current ply
+ * @param walk walk of the observers; Empty if it isn't restricted
+ * @param evaluate identifies the set of restrictions imposed on the observation
+ * @param is_observed the answer
+ */
+void observation_cache_remember(piece_walk_type walk,
+                                validator_id evaluate,
+                                boolean is_observed);
+
+#endif
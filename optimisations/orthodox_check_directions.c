@@ -1,4 +1,5 @@
 #include "optimisations/orthodox_check_directions.h"
+#include "optimisations/orthodox_square_observation.h"
 #include "position/position.h"
 #include "solving/pipe.h"
 
@@ -56,5 +57,7 @@ static void InitCheckDir(void)
 void check_dir_initialiser_solve(slice_index si)
 {
   InitCheckDir();
+  initialise_orthodox_square_observation();
+  initialise_vectors_to_board();
   pipe_solve_delegate(si);
 }
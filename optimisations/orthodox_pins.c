@@ -0,0 +1,246 @@
+#include "optimisations/orthodox_pins.h"
+#include "optimisations/orthodox_square_observation.h"
+#include "optimisations/orthodox_check_directions.h"
+#include "optimisations/observation.h"
+#include "conditions/conditions.h"
+#include "pieces/pieces.h"
+#include "position/position.h"
+#include "stipulation/stipulation.h"
+#include "stipulation/pipe.h"
+#include "stipulation/slice_insertion.h"
+#include "solving/has_solution_type.h"
+#include "solving/check.h"
+#include "solving/move_generator.h"
+#include "solving/ply.h"
+#include "solving/pipe.h"
+#include "utilities/bitmask.h"
+#include "debugging/trace.h"
+
+#include "debugging/assert.h"
+
+/* what we know about the pins in the position where the moves of a ply are
+ * generated */
+static struct
+{
+    boolean is_known;
+    Side side;
+    square sq_king;
+    square_set_type pinned;
+} pins[maxply+1];
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void orthodox_pins_detector_solve(slice_index si)
+{
+  Side const side = trait[nbply];
+  square const sq_king = being_solved.king_square[side];
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  /* the pins only tell the whole story if the king isn't in check */
+  pins[nbply].is_known = (sq_king!=initsquare
+                          && get_walk_of_piece_on_square(sq_king)==King
+                          && !is_in_check(side));
+  if (pins[nbply].is_known)
+  {
+    pins[nbply].side = side;
+    pins[nbply].sq_king = sq_king;
+    pins[nbply].pinned = find_pinned_pieces_ortho(side,sq_king);
+  }
+
+  pipe_solve_delegate(si);
+
+  pins[nbply].is_known = false;
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Determine whether the legality of the move just played follows from the
+ * pins detected before it was played
+ * @param side side that has played the move
+ * @return true iff the move's legality is known
+ */
+static boolean is_legality_known(Side side)
+{
+  boolean result = false;
+
+  if (pins[nbply].is_known && pins[nbply].side==side)
+  {
+    move_generation_elmt const * const move = &move_generation_stack[CURRMOVE_OF_PLY(nbply)];
+
+    /* en passant captures may uncover a line through the captured pawn */
+    result = (move->departure!=pins[nbply].sq_king
+              && is_on_board(move->departure)
+              && (move->capture==move->arrival || move->capture==pawn_multistep));
+  }
+
+  return result;
+}
+
+/* Determine whether a move leaves the king in check although it didn't start
+ * in check
+ * @return true iff the move moves a pinned piece off its line
+ */
+static boolean is_pin_violated(void)
+{
+  move_generation_elmt const * const move = &move_generation_stack[CURRMOVE_OF_PLY(nbply)];
+  square const sq_king = pins[nbply].sq_king;
+
+  return ((pins[nbply].pinned & square_set_element(move->departure))!=0
+          && CheckDir[Queen][move->arrival-sq_king]!=CheckDir[Queen][move->departure-sq_king]);
+}
+
+/* Determine whether the move just played has left the king of the moving
+ * side in check, using the pins detected before it was played if possible
+ * @param side side that has played the move
+ * @return true iff the move is illegal
+ */
+boolean orthodox_is_in_selfcheck(Side side)
+{
+  if (is_legality_known(side))
+  {
+    assert(is_pin_violated()==is_in_check(side));
+    return is_pin_violated();
+  }
+  else
+    return is_in_check(side);
+}
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void orthodox_selfcheck_guard_solve(slice_index si)
+{
+  Side const side = advers(SLICE_STARTER(si));
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  if (orthodox_is_in_selfcheck(side))
+    solve_result = previous_move_is_illegal;
+  else
+    pipe_solve_delegate(si);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Determine whether the pins tell whether a move is legal
+ * @return true iff nothing but the orthodox rules decides about legality
+ */
+static boolean is_problem_orthodox(void)
+{
+  Flags const orthodox_flags = BIT(piece_flag_white)|BIT(piece_flag_black)|BIT(Royal);
+  unsigned int i;
+
+  if (piece_walk_may_exist_fairy || (some_pieces_flags&~orthodox_flags)!=0)
+    return false;
+
+  for (i = 0; i!=CondCount; ++i)
+    if (CondFlag[i])
+      return false;
+
+  for (i = 0; i!=ExtraCondCount; ++i)
+    if (ExtraCondFlag[i])
+      return false;
+
+  return (is_observation_trivially_validated(White)
+          && is_observation_trivially_validated(Black));
+}
+
+static void insert_detector(slice_index si, stip_structure_traversal *st)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  stip_traverse_structure_children(si,st);
+
+  {
+    slice_index const prototype = alloc_pipe(STOrthodoxPinsDetector);
+    slice_insertion_insert_contextually(si,st->context,&prototype,1);
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+static void substitute_guard(slice_index guard)
+{
+  slice_index const substitute = alloc_pipe(STOrthodoxSelfCheckGuard);
+  SLICE_STARTER(substitute) = SLICE_STARTER(guard);
+  SLICE_TESTER(substitute) = SLICE_TESTER(guard);
+  pipe_substitute(guard,substitute);
+}
+
+static void optimise_guard(slice_index si, stip_structure_traversal *st)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  stip_traverse_structure_children_pipe(si,st);
+
+  if (SLICE_TESTER(si)!=no_slice && SLICE_TYPE(SLICE_TESTER(si))==STSelfCheckGuard)
+    /* substitute unreachable tester slice */
+    substitute_guard(SLICE_TESTER(si));
+
+  substitute_guard(si);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Optimise the self-check guards if the problem is orthodox enough
+ * @param si identifies the root slice of the solving machinery
+ */
+void solving_optimise_with_orthodox_pins(slice_index si)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  TraceStipulation(si);
+
+  if (is_problem_orthodox())
+  {
+    stip_structure_traversal st;
+
+    stip_structure_traversal_init(&st,0);
+    stip_structure_traversal_override_single(&st,
+                                             STDoneGeneratingMoves,
+                                             &insert_detector);
+    stip_structure_traversal_override_single(&st,
+                                             STSelfCheckGuard,
+                                             &optimise_guard);
+    stip_traverse_structure(si,&st);
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
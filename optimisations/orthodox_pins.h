@@ -0,0 +1,59 @@
+#if !defined(OPTIMISATIONS_ORTHODOX_PINS_H)
+#define OPTIMISATIONS_ORTHODOX_PINS_H
+
+#include "position/side.h"
+#include "solving/machinery/solve.h"
+#include "utilities/boolean.h"
+
+/* This module optimises the self-check guards in orthodox play: the pieces
+ * pinned to the king of the side to move are determined before that side's
+ * moves are played. The legality of a move by a piece other than the king
+ * then follows from the pins, and the guard doesn't have to test whether the
+ * king has been exposed.
+ * King moves, en passant captures and moves out of check are still tested
+ * after they have been played.
+ */
+
+/* Optimise the self-check guards if the problem is orthodox enough
+ * @param si identifies the root slice of the solving machinery
+ */
+void solving_optimise_with_orthodox_pins(slice_index si);
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void orthodox_pins_detector_solve(slice_index si);
+
+/* Determine whether the move just played has left the king of the moving
+ * side in check, using the pins detected before it was played if possible
+ * @param side side that has played the move
+ * @return true iff the move is illegal
+ */
+boolean orthodox_is_in_selfcheck(Side side);
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void orthodox_selfcheck_guard_solve(slice_index si);
+
+#endif
@@ -4,32 +4,187 @@
 #include "position/position.h"
 #include "debugging/trace.h"
 #include "pieces/pieces.h"
-
-static boolean leapers_check_ortho(Side side_checking,
-                                   square sq_king,
-                                   vec_index_type kanf, vec_index_type kend,
-                                   piece_walk_type p)
+#include "debugging/assert.h"
+
+/* squares from which a piece observes a square, indexed by the index of the
+ * observed square in the sets of squares (see square_set_index()) */
+static square_set_type king_observers[nr_squares_on_board];
+static square_set_type knight_observers[nr_squares_on_board];
+static square_set_type pawn_observers[nr_sides][nr_squares_on_board];
+static square_set_type orthogonal_neighbours[nr_squares_on_board];
+static square_set_type diagonal_neighbours[nr_squares_on_board];
+
+/* squares reached from a square by moving along a line, indexed by vector
+ * index and square index */
+static square_set_type lines[vec_queen_end+1][nr_squares_on_board];
+
+/* Determine the squares reached from a square by a leap
+ * @param sq_departure departure square
+ * @param kanf kend indices of the vectors of the leap
+ * @return set of squares on the board reached
+ */
+static square_set_type leaps(square sq_departure,
+                             vec_index_type kanf, vec_index_type kend)
 {
+  square_set_type result = 0;
   vec_index_type k;
-  for (k = kanf; k<=kend; k++)
+
+  for (k = kanf; k<=kend; ++k)
+    if (is_on_board(sq_departure+vec[k]))
+      result |= square_set_element(sq_departure+vec[k]);
+
+  return result;
+}
+
+/* Initialise the tables used for detecting observations by orthodox pieces
+ */
+void initialise_orthodox_square_observation(void)
+{
+  unsigned int i;
+
+  for (i = 0; i!=nr_squares_on_board; ++i)
   {
-    square const sq_departure = sq_king+vec[k];
-    if (get_walk_of_piece_on_square(sq_departure)==p
-        && TSTFLAG(being_solved.spec[sq_departure],side_checking))
-      return true;
+    square const sq = boardnum[i];
+    vec_index_type k;
+
+    assert(square_set_index(sq)==i);
+
+    king_observers[i] = leaps(sq,vec_queen_start,vec_queen_end);
+    knight_observers[i] = leaps(sq,vec_knight_start,vec_knight_end);
+    orthogonal_neighbours[i] = leaps(sq,vec_rook_start,vec_rook_end);
+    diagonal_neighbours[i] = leaps(sq,vec_bishop_start,vec_bishop_end);
+
+    pawn_observers[White][i] = 0;
+    if (is_on_board(sq+dir_down+dir_left))
+      pawn_observers[White][i] |= square_set_element(sq+dir_down+dir_left);
+    if (is_on_board(sq+dir_down+dir_right))
+      pawn_observers[White][i] |= square_set_element(sq+dir_down+dir_right);
+
+    pawn_observers[Black][i] = 0;
+    if (is_on_board(sq+dir_up+dir_left))
+      pawn_observers[Black][i] |= square_set_element(sq+dir_up+dir_left);
+    if (is_on_board(sq+dir_up+dir_right))
+      pawn_observers[Black][i] |= square_set_element(sq+dir_up+dir_right);
+
+    for (k = vec_queen_start; k<=vec_queen_end; ++k)
+    {
+      square s;
+      lines[k][i] = 0;
+      for (s = sq+vec[k]; is_on_board(s); s += vec[k])
+        lines[k][i] |= square_set_element(s);
+    }
+  }
+}
+
+/* Find the first obstacle along a line
+ * @param sq_target index of the square where the line starts
+ * @param k index of the vector of the line
+ * @return set containing the first non-empty square of the line; empty if
+ *         there is none
+ */
+static square_set_type find_end_of_line_in_sets(unsigned int sq_target,
+                                                vec_index_type k)
+{
+  square_set_type const obstacles = lines[k][sq_target] & being_solved.non_empty;
+
+  if (obstacles==0)
+    return 0;
+  else if (vec[k]>0)
+    /* the squares of the line have increasing indices */
+    return obstacles & -obstacles;
+  else
+  {
+#if defined(__GNUC__)
+    return (square_set_type)1<<(63-__builtin_clzll(obstacles));
+#else
+    square_set_type result = obstacles;
+    while ((result&(result-1))!=0)
+      result &= result-1;
+    return result;
+#endif
   }
+}
+
+/* Determine whether a square is observed by a rider along some lines
+ * @param sq_target index of the observed square
+ * @param kanf kend indices of the vectors of the lines
+ * @param riders set of the squares of the observing riders
+ * @return true iff one of riders observes sq_target
+ */
+static boolean riders_check_ortho(unsigned int sq_target,
+                                  vec_index_type kanf, vec_index_type kend,
+                                  square_set_type riders)
+{
+  vec_index_type k;
+
+  for (k = kanf; k<=kend; ++k)
+    if ((lines[k][sq_target] & riders)!=0
+        && (find_end_of_line_in_sets(sq_target,k) & riders)!=0)
+      return true;
 
   return false;
 }
 
-static boolean king_check_ortho(Side side_checking, square sq_king)
+/* Find the piece pinned along a line
+ * @param sq_king index of the square of the king
+ * @param k index of the vector of the line
+ * @param own set of the squares occupied by the king's side
+ * @param pinners set of the squares of the opposite riders moving along the
+ *                line
+ * @return set containing the pinned piece; empty if there is none
+ */
+static square_set_type find_pinned_piece_on_line(unsigned int sq_king,
+                                                 vec_index_type k,
+                                                 square_set_type own,
+                                                 square_set_type pinners)
 {
-  return leapers_check_ortho(side_checking,sq_king, vec_queen_start,vec_queen_end, King);
+  if ((lines[k][sq_king] & pinners)==0)
+    return 0;
+  else
+  {
+    square_set_type const first = find_end_of_line_in_sets(sq_king,k);
+
+    if ((first & own)==0)
+      return 0;
+    else
+    {
+      square_set_type remaining = first;
+      unsigned int const sq_first = square_set_index(square_set_pop_first(&remaining));
+
+      if ((find_end_of_line_in_sets(sq_first,k) & pinners)==0)
+        return 0;
+      else
+        return first;
+    }
+  }
 }
 
-static boolean knight_check_ortho(Side side_checking, square sq_king)
+/* Find the pieces pinned to a king by orthodox riders
+ * @param side side of the king
+ * @param sq_king square of the king
+ * @return set of the squares of the pieces of side that can't leave the line
+ *         between sq_king and an opposite rider without exposing the king
+ */
+square_set_type find_pinned_pieces_ortho(Side side, square sq_king)
 {
-  return leapers_check_ortho(side_checking,sq_king, vec_knight_start,vec_knight_end, Knight);
+  unsigned int const king = square_set_index(sq_king);
+  Side const opponent = advers(side);
+  square_set_type const own = get_squares_occupied_by(side);
+  square_set_type const queens = get_squares_occupied_by_walk(opponent,Queen);
+  square_set_type const orthogonal = queens|get_squares_occupied_by_walk(opponent,Rook);
+  square_set_type const diagonal = queens|get_squares_occupied_by_walk(opponent,Bishop);
+  square_set_type result = 0;
+  vec_index_type k;
+
+  if (orthogonal!=0)
+    for (k = vec_rook_start; k<=vec_rook_end; ++k)
+      result |= find_pinned_piece_on_line(king,k,own,orthogonal);
+
+  if (diagonal!=0)
+    for (k = vec_bishop_start; k<=vec_bishop_end; ++k)
+      result |= find_pinned_piece_on_line(king,k,own,diagonal);
+
+  return result;
 }
 
 static boolean pawn_test_check_ortho(Side side_checking, square sq_departure)
@@ -98,9 +253,8 @@ static boolean pawn_check_ortho(Side side_checking, square sq_king)
     numvec const dir_forward_right = dir_forward+dir_right;
     numvec const dir_forward_left = dir_forward+dir_left;
 
-    if (pawn_test_check_ortho(side_checking,sq_king-dir_forward_right))
-      result = true;
-    else if (pawn_test_check_ortho(side_checking,sq_king-dir_forward_left))
+    if ((pawn_observers[side_checking][square_set_index(sq_king)]
+         & get_squares_occupied_by_walk(side_checking,Pawn))!=0)
       result = true;
     else if (en_passant_test_check_ortho(side_checking,sq_king,dir_forward_right))
       result = true;
@@ -117,42 +271,32 @@ static boolean pawn_check_ortho(Side side_checking, square sq_king)
 boolean is_square_observed_ortho(Side side_checking,
                                  square sq_target)
 {
-  if (being_solved.number_of_pieces[side_checking][King]>0
-      && king_check_ortho(side_checking,sq_target))
+  unsigned int const target = square_set_index(sq_target);
+
+  if ((king_observers[target]
+       & get_squares_occupied_by_walk(side_checking,King))!=0)
     return true;
 
   if (being_solved.number_of_pieces[side_checking][Pawn]>0
       && pawn_check_ortho(side_checking,sq_target))
     return true;
 
-  if (being_solved.number_of_pieces[side_checking][Knight]>0
-      && knight_check_ortho(side_checking,sq_target))
+  if ((knight_observers[target]
+       & get_squares_occupied_by_walk(side_checking,Knight))!=0)
     return true;
 
-  if (being_solved.number_of_pieces[side_checking][Queen]>0
-      || being_solved.number_of_pieces[side_checking][Rook]>0)
   {
-    vec_index_type k;
-    for (k= vec_rook_end; k>=vec_rook_start; k--)
-    {
-      square const sq_departure = find_end_of_line(sq_target,vec[k]);
-      piece_walk_type const p = get_walk_of_piece_on_square(sq_departure);
-      if ((p==Rook || p==Queen) && TSTFLAG(being_solved.spec[sq_departure],side_checking))
-        return true;
-    }
-  }
+    square_set_type const queens = get_squares_occupied_by_walk(side_checking,Queen);
+    square_set_type const rooks = get_squares_occupied_by_walk(side_checking,Rook);
+    square_set_type const bishops = get_squares_occupied_by_walk(side_checking,Bishop);
 
-  if (being_solved.number_of_pieces[side_checking][Queen]>0
-      || being_solved.number_of_pieces[side_checking][Bishop]>0)
-  {
-    vec_index_type k;
-    for (k= vec_bishop_start; k<=vec_bishop_end; k++)
-    {
-      square const sq_departure = find_end_of_line(sq_target,vec[k]);
-      piece_walk_type const p = get_walk_of_piece_on_square(sq_departure);
-      if ((p==Bishop || p==Queen) && TSTFLAG(being_solved.spec[sq_departure],side_checking))
-        return true;
-    }
+    if ((queens|rooks)!=0
+        && riders_check_ortho(target,vec_rook_start,vec_rook_end,queens|rooks))
+      return true;
+
+    if ((queens|bishops)!=0
+        && riders_check_ortho(target,vec_bishop_start,vec_bishop_end,queens|bishops))
+      return true;
   }
 
   {
@@ -172,24 +316,23 @@ boolean is_square_observed_ortho(Side side_checking,
 
 boolean is_square_uninterceptably_observed_ortho(Side side_checking, square sq_target)
 {
+  unsigned int const target = square_set_index(sq_target);
+  square_set_type const queens = get_squares_occupied_by_walk(side_checking,Queen);
+
   if (being_solved.number_of_pieces[side_checking][Pawn]>0
       && pawn_check_ortho(side_checking,sq_target))
     return true;
 
-  if (being_solved.number_of_pieces[side_checking][Knight]>0
-      && knight_check_ortho(side_checking,sq_target))
-    return true;
-
-  if (being_solved.number_of_pieces[side_checking][Rook]>0
-      && leapers_check_ortho(side_checking,sq_target, vec_rook_start,vec_rook_end, Rook))
+  if ((knight_observers[target]
+       & get_squares_occupied_by_walk(side_checking,Knight))!=0)
     return true;
 
-  if (being_solved.number_of_pieces[side_checking][Bishop]>0
-      && leapers_check_ortho(side_checking,sq_target, vec_bishop_start,vec_bishop_end, Bishop))
+  if ((orthogonal_neighbours[target]
+       & (queens|get_squares_occupied_by_walk(side_checking,Rook)))!=0)
     return true;
 
-  if (being_solved.number_of_pieces[side_checking][Queen]>0
-      && leapers_check_ortho(side_checking,sq_target, vec_queen_start,vec_queen_end, Queen))
+  if ((diagonal_neighbours[target]
+       & (queens|get_squares_occupied_by_walk(side_checking,Bishop)))!=0)
     return true;
 
   return false;
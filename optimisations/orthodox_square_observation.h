@@ -3,16 +3,30 @@
 
 #include "position/side.h"
 #include "position/board.h"
+#include "position/position.h"
 #include "utilities/boolean.h"
 
 /* This module implements an optimised algorithm for detecting square
- * observations
+ * observations; observations by orthodox pieces are detected using the sets
+ * of squares occupied by the orthodox walks maintained in being_solved
  */
 
+/* Initialise the tables used for detecting observations by orthodox pieces
+ */
+void initialise_orthodox_square_observation(void);
+
 boolean is_square_observed_ortho(Side side_checking,
                                  square sq_target);
 
 boolean is_square_uninterceptably_observed_ortho(Side side_checking,
                                                  square sq_target);
 
+/* Find the pieces pinned to a king by orthodox riders
+ * @param side side of the king
+ * @param sq_king square of the king
+ * @return set of the squares of the pieces of side that can't leave the line
+ *         between sq_king and an opposite rider without exposing the king
+ */
+square_set_type find_pinned_pieces_ortho(Side side, square sq_king);
+
 #endif
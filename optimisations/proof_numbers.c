@@ -0,0 +1,618 @@
+#include "optimisations/proof_numbers.h"
+#include "optimisations/hash.h"
+#include "optimisations/lockless_hash.h"
+#include "position/position.h"
+#include "position/underworld.h"
+#include "stipulation/stipulation.h"
+#include "stipulation/pipe.h"
+#include "stipulation/proxy.h"
+#include "stipulation/battle_play/branch.h"
+#include "solving/avoid_unsolvable.h"
+#include "solving/has_solution_type.h"
+#include "solving/machinery/slack_length.h"
+#include "solving/ply.h"
+#include "solving/pipe.h"
+#include "debugging/trace.h"
+
+#include "debugging/assert.h"
+#include <limits.h>
+#include <stdlib.h>
+
+typedef unsigned int proof_number_type;
+
+#define proof_number_infinity UINT_MAX
+
+typedef enum
+{
+  attack_node,  /* OR node: one attack has to solve */
+  defense_node  /* AND node: each defense has to be met */
+} node_type;
+
+/* proof and disproof numbers of a node; a node is proven iff pn==0 and
+ * disproven iff dn==0 */
+typedef struct
+{
+    lockless_hash_key_type key;
+    slice_index node;
+    stip_length_type remaining;
+    proof_number_type pn;
+    proof_number_type dn;
+    stip_length_type result; /* solve_result of a (dis)proven node */
+} table_entry_type;
+
+enum
+{
+  /* the table takes the memory lent by the hash table, but no more than this
+   * many entries and at least this many */
+  max_table_size = 1<<19,
+  min_table_size = 1<<12,
+
+  /* nodes with at most this many half-moves left are solved depth-first */
+  max_nr_half_moves_depth_first = 5
+};
+
+/* allocated while a twin is solved (cf. proof_number_table_opener_solve()) */
+static table_entry_type *table;
+static unsigned long table_size;
+
+/* what we know about a node while its children are iterated over */
+typedef struct
+{
+    ply ply;
+    node_type type;
+    stip_length_type remaining;
+
+    /* the child to be searched during the current iteration */
+    boolean is_target_pending;
+    lockless_hash_key_type target_key;
+    proof_number_type target_thpn;
+    proof_number_type target_thdn;
+
+    /* the children that are neither proven nor disproven;
+     * "decisive" is the pn of the children of an attack node and the dn of the
+     * children of a defense node, "other" is the other number */
+    unsigned int nr_unresolved;
+    proof_number_type sum_other;
+    proof_number_type best_decisive;
+    proof_number_type second_best_decisive;
+    proof_number_type other_of_best;
+    lockless_hash_key_type key_of_best;
+} search_context_type;
+
+/* the node whose children are currently iterated over */
+static search_context_type *current_context;
+
+static proof_number_type add(proof_number_type pn1, proof_number_type pn2)
+{
+  if (pn1>=proof_number_infinity-pn2)
+    return proof_number_infinity;
+  else
+    return pn1+pn2;
+}
+
+static lockless_hash_key_type calc_key(void)
+{
+  byte buffer[hashbuf_length];
+  byte *bp = buffer;
+  underworld_index_type gi;
+
+  *bp++ = (byte)trait[nbply];
+
+  for (gi = 0; gi<nr_ghosts; ++gi)
+  {
+    square s = (underworld[gi].on
+                - nr_of_slack_rows_below_board*onerow
+                - nr_of_slack_files_left_of_board);
+    bp = SmallEncodePiece(bp,
+                          s/onerow,s%onerow,
+                          underworld[gi].walk,underworld[gi].flags);
+  }
+
+  bp = CommonEncode(bp,slack_length,0);
+
+  return being_solved.hash_key ^ lockless_hash_key(buffer,(unsigned int)(bp-buffer));
+}
+
+static table_entry_type *get_entry(lockless_hash_key_type key, slice_index si)
+{
+  unsigned long const index = (unsigned long)((key
+                                               + si*2654435761u
+                                               + solve_nr_remaining*40503u)
+                                              % table_size);
+  return &table[index];
+}
+
+static boolean is_entry_of(table_entry_type const *entry,
+                           lockless_hash_key_type key,
+                           slice_index si)
+{
+  return (entry->key==key
+          && entry->node==si
+          && entry->remaining==solve_nr_remaining);
+}
+
+static void store(lockless_hash_key_type key, slice_index si,
+                  proof_number_type pn, proof_number_type dn)
+{
+  table_entry_type * const entry = get_entry(key,si);
+
+  entry->key = key;
+  entry->node = si;
+  entry->remaining = solve_nr_remaining;
+  entry->pn = pn;
+  entry->dn = dn;
+  entry->result = solve_result;
+}
+
+/* Iterate over the children of a node until it is proven or disproven or one
+ * of the thresholds is reached
+ * @param si slice index
+ * @param type type of node
+ * @param key key of the position
+ * @param thpn threshold for the proof number
+ * @param thdn threshold for the disproof number
+ * @param pn where to return the proof number
+ * @param dn where to return the disproof number
+ * @note if the node is proven or disproven, solve_result holds the result of
+ *       solving it
+ */
+static void search(slice_index si, node_type type, lockless_hash_key_type key,
+                   proof_number_type thpn, proof_number_type thdn,
+                   proof_number_type *pn, proof_number_type *dn)
+{
+  search_context_type * const save_context = current_context;
+  stip_length_type const save_max_unsolvable = max_unsolvable;
+  search_context_type context;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParam("%u",type);
+  TraceFunctionParam("%u",thpn);
+  TraceFunctionParam("%u",thdn);
+  TraceFunctionParamListEnd();
+
+  context.ply = nbply;
+  context.type = type;
+  context.remaining = solve_nr_remaining;
+  context.is_target_pending = false;
+
+  while (true)
+  {
+    context.nr_unresolved = 0;
+    context.sum_other = 0;
+    context.best_decisive = proof_number_infinity;
+    context.second_best_decisive = proof_number_infinity;
+
+    /* what the children learn about unsolvability is based on their
+     * provisional results */
+    max_unsolvable = save_max_unsolvable;
+
+    current_context = &context;
+    pipe_solve_delegate(si);
+    current_context = save_context;
+
+    if (move_has_solved()==(type==attack_node) || context.nr_unresolved==0)
+    {
+      /* the children that have been iterated over decide */
+      *pn = move_has_solved() ? 0 : proof_number_infinity;
+      *dn = move_has_solved() ? proof_number_infinity : 0;
+    }
+    else if (type==attack_node)
+    {
+      *pn = context.best_decisive;
+      *dn = context.sum_other;
+    }
+    else
+    {
+      *pn = context.sum_other;
+      *dn = context.best_decisive;
+    }
+
+    TraceValue("%u",*pn);
+    TraceValue("%u",*dn);
+    TraceEOL();
+
+    store(key,si,*pn,*dn);
+
+    if (*pn>=thpn || *dn>=thdn)
+      break;
+    else
+    {
+      proof_number_type const second_best = add(context.second_best_decisive,
+                                                1+context.second_best_decisive/4);
+      context.is_target_pending = true;
+      context.target_key = context.key_of_best;
+
+      if (type==attack_node)
+      {
+        context.target_thpn = thpn<second_best ? thpn : second_best;
+        context.target_thdn = (thdn==proof_number_infinity
+                               ? proof_number_infinity
+                               : thdn-*dn+context.other_of_best);
+      }
+      else
+      {
+        context.target_thdn = thdn<second_best ? thdn : second_best;
+        context.target_thpn = (thpn==proof_number_infinity
+                               ? proof_number_infinity
+                               : thpn-*pn+context.other_of_best);
+      }
+    }
+  }
+
+  max_unsolvable = save_max_unsolvable;
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Solve a node close to the end of the branch depth-first; the moves of such
+ * nodes are cheaper to play again than to search
+ * @param si slice index
+ */
+static void solve_depth_first(slice_index si)
+{
+  lockless_hash_key_type const key = calc_key();
+  table_entry_type const * const entry = get_entry(key,si);
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  if (is_entry_of(entry,key,si))
+    solve_result = entry->result;
+  else
+  {
+    search_context_type * const save_context = current_context;
+
+    current_context = 0;
+    pipe_solve_delegate(si);
+    current_context = save_context;
+
+    if (move_has_solved())
+      store(key,si,0,proof_number_infinity);
+    else
+      store(key,si,proof_number_infinity,0);
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Report an unresolved child to the node iterating over its children */
+static void report_unresolved(search_context_type *parent,
+                              lockless_hash_key_type key,
+                              proof_number_type pn, proof_number_type dn)
+{
+  proof_number_type const decisive = parent->type==attack_node ? pn : dn;
+  proof_number_type const other = parent->type==attack_node ? dn : pn;
+
+  ++parent->nr_unresolved;
+  parent->sum_other = add(parent->sum_other,other);
+
+  if (decisive<parent->best_decisive)
+  {
+    parent->second_best_decisive = parent->best_decisive;
+    parent->best_decisive = decisive;
+    parent->other_of_best = other;
+    parent->key_of_best = key;
+  }
+  else if (decisive<parent->second_best_decisive)
+    parent->second_best_decisive = decisive;
+}
+
+/* Deal with a node whose parent is iterating over its children
+ * @param si slice index
+ * @param type type of node
+ */
+static void solve_child(slice_index si, node_type type)
+{
+  search_context_type * const parent = current_context;
+  lockless_hash_key_type const key = calc_key();
+  table_entry_type const * const entry = get_entry(key,si);
+  proof_number_type pn = 1;
+  proof_number_type dn = 1;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  if (is_entry_of(entry,key,si))
+  {
+    pn = entry->pn;
+    dn = entry->dn;
+    solve_result = entry->result;
+  }
+
+  if (pn!=0 && dn!=0 && parent->is_target_pending && parent->target_key==key)
+  {
+    parent->is_target_pending = false;
+    search(si,type,key,parent->target_thpn,parent->target_thdn,&pn,&dn);
+  }
+
+  if (pn!=0 && dn!=0)
+  {
+    report_unresolved(parent,key,pn,dn);
+
+    /* let the parent go on with its next child */
+    solve_result = (type==attack_node
+                    ? MOVE_HAS_SOLVED_LENGTH()
+                    : MOVE_HAS_NOT_SOLVED_LENGTH());
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Determine whether a node is a child of the node iterating over its children
+ */
+static boolean is_child_of_current_node(node_type type)
+{
+  return (current_context!=0
+          && current_context->type!=type
+          && current_context->ply==parent_ply[nbply]);
+}
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void proof_number_attack_node_solve(slice_index si)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  if (table==0)
+    pipe_solve_delegate(si);
+  else if (is_child_of_current_node(attack_node)
+           && solve_nr_remaining+1<current_context->remaining)
+    /* STFindShortest is trying the shorter lengths; the parent's proof
+     * numbers refer to the full length */
+    solve_result = MOVE_HAS_NOT_SOLVED_LENGTH();
+  else if (solve_nr_remaining<=slack_length+max_nr_half_moves_depth_first)
+    solve_depth_first(si);
+  else if (is_child_of_current_node(attack_node))
+    solve_child(si,attack_node);
+  else
+  {
+    lockless_hash_key_type const key = calc_key();
+    table_entry_type const * const entry = get_entry(key,si);
+
+    if (is_entry_of(entry,key,si) && (entry->pn==0 || entry->dn==0))
+      solve_result = entry->result;
+    else
+    {
+      proof_number_type pn;
+      proof_number_type dn;
+      search(si,attack_node,key,
+             proof_number_infinity,proof_number_infinity,
+             &pn,&dn);
+      assert(pn==0 || dn==0);
+    }
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void proof_number_defense_node_solve(slice_index si)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  if (table!=0
+      && solve_nr_remaining>slack_length+max_nr_half_moves_depth_first
+      && is_child_of_current_node(defense_node))
+    solve_child(si,defense_node);
+  else
+  {
+    /* e.g. testing the continuations of a key; each defense is searched
+     * separately */
+    search_context_type * const save_context = current_context;
+    current_context = 0;
+    pipe_solve_delegate(si);
+    current_context = save_context;
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Allocate the node table from the memory of the hash table
+ */
+static void allocate_table(void)
+{
+  unsigned long const max_kilos = max_table_size*sizeof table[0]/1024;
+  unsigned long const nr_kilos = hash_lend_memory(max_kilos);
+
+  table_size = nr_kilos*1024/sizeof table[0];
+  if (table_size<min_table_size)
+    table_size = min_table_size;
+
+  table = malloc(table_size*sizeof table[0]);
+  if (table==0)
+  {
+    table_size = min_table_size;
+    table = malloc(table_size*sizeof table[0]);
+  }
+
+  if (table!=0)
+  {
+    unsigned long i;
+    for (i = 0; i!=table_size; ++i)
+      table[i].node = no_slice;
+  }
+}
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void proof_number_table_opener_solve(slice_index si)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  /* without a table, the searching slices leave the testing to the slices
+   * below them */
+  allocate_table();
+
+  current_context = 0;
+  pipe_solve_delegate(si);
+
+  free(table);
+  table = 0;
+
+  hash_lend_memory(0);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+static void insert_searchers(slice_index si, stip_structure_traversal *st)
+{
+  boolean const * const are_we_enforcing_threats = st->param;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  stip_traverse_structure_children_pipe(si,st);
+
+  /* the attack nodes tested by STFindShortest are tested with increasing
+   * length; each search thus determines whether there is a solution of one
+   * particular length */
+  if (st->activity==stip_traversal_activity_testing
+      && st->context==stip_traversal_context_attack
+      && !*are_we_enforcing_threats)
+  {
+    slice_index const prototypes[] =
+    {
+        alloc_pipe(STProofNumberAttackNode),
+        alloc_pipe(STProofNumberDefenseNode)
+    };
+    enum { nr_prototypes = sizeof prototypes / sizeof prototypes[0] };
+    attack_branch_insert_slices(si,prototypes,nr_prototypes);
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* the results of the attack nodes that decide whether a defense defeats the
+ * threats depend on the threats, not only on the position */
+static void remember_enforcing_threats(slice_index si,
+                                       stip_structure_traversal *st)
+{
+  boolean * const are_we_enforcing_threats = st->param;
+  boolean const save_enforcing = *are_we_enforcing_threats;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  stip_traverse_structure_children_pipe(si,st);
+
+  *are_we_enforcing_threats = true;
+  stip_traverse_structure_testing_pipe_tester(si,st);
+  *are_we_enforcing_threats = save_enforcing;
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+static void forget_enforcing_threats(slice_index si,
+                                     stip_structure_traversal *st)
+{
+  boolean * const are_we_enforcing_threats = st->param;
+  boolean const save_enforcing = *are_we_enforcing_threats;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  *are_we_enforcing_threats = false;
+  stip_traverse_structure_children_pipe(si,st);
+  *are_we_enforcing_threats = save_enforcing;
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+static structure_traversers_visitor const searcher_inserters[] =
+{
+  { STFindShortest,         &insert_searchers           },
+  { STThreatEnforcer,       &remember_enforcing_threats },
+  { STThreatDefeatedTester, &forget_enforcing_threats   }
+};
+
+enum
+{
+  nr_searcher_inserters = (sizeof searcher_inserters
+                           / sizeof searcher_inserters[0])
+};
+
+/* Instrument the solving machinery with the slice allocating the node table
+ * and the testing branches of battle play with the searching slices
+ * @param si identifies the root slice of the solving machinery
+ */
+void solving_insert_proof_number_search(slice_index si)
+{
+  stip_structure_traversal st;
+  boolean are_we_enforcing_threats = false;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  {
+    /* the hash table is opened with the memory that the node table leaves */
+    slice_index const opener = alloc_pipe(STProofNumberTableOpener);
+    pipe_append(si,opener);
+    SLICE_TESTER(opener) = alloc_proxy_slice();
+    pipe_append(SLICE_TESTER(si),SLICE_TESTER(opener));
+  }
+
+  stip_structure_traversal_init(&st,&are_we_enforcing_threats);
+  stip_structure_traversal_override(&st,
+                                    searcher_inserters,
+                                    nr_searcher_inserters);
+  stip_traverse_structure(si,&st);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
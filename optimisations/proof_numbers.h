@@ -0,0 +1,77 @@
+#if !defined(OPTIMISATIONS_PROOF_NUMBERS_H)
+#define OPTIMISATIONS_PROOF_NUMBERS_H
+
+#include "solving/machinery/solve.h"
+
+/* This module implements option ProofNumbers: the attack nodes of battle play
+ * (#n, s#n ...) are tested using depth-first proof-number search (df-pn)
+ * rather than by playing the moves depth-first.
+ *
+ * An attack node is an OR node (the attacker has to find one solving move), a
+ * defense node is an AND node (each defense has to be met). The search
+ * expands the most proving node first and keeps the proof and disproof
+ * numbers of the nodes visited in a table of limited size. The table takes
+ * its memory from the hash table while a twin is solved (cf. -maxmem). An
+ * entry that has been overwritten is simply searched again. The nodes close
+ * to the end of the branch are solved depth-first, and their results are
+ * kept in the same table.
+ *
+ * The moves of a node are generated, played and tested by the regular solving
+ * machinery; the searching slices inserted into the testing branches just
+ * decide which nodes are expanded.
+ * Solutions are written by the regular writers, i.e. the output doesn't
+ * depend on whether the option is used.
+ */
+
+/* Instrument the solving machinery with the slice allocating the node table
+ * and the testing branches of battle play with the searching slices
+ * @param si identifies the root slice of the solving machinery
+ */
+void solving_insert_proof_number_search(slice_index si);
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void proof_number_table_opener_solve(slice_index si);
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void proof_number_attack_node_solve(slice_index si);
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void proof_number_defense_node_solve(slice_index si);
+
+#endif
@@ -8,6 +8,8 @@
 #include "solving/ply.h"
 #include "solving/pipe.h"
 #include "options/movenumbers/restart_guard_intelligent.h"
+#include "options/movenumbers/root_move_splitter.h"
+#include "options/options.h"
 #include "output/output.h"
 #include "output/plaintext/plaintext.h"
 #include "output/plaintext/protocol.h"
@@ -138,15 +140,23 @@ void restart_guard_solve(slice_index si)
   TraceFunctionParam("%u",si);
   TraceFunctionParamListEnd();
 
-  WriteMoveNbr(si);
+  if (root_move_splitter_is_move_ours())
+  {
+    if (OptFlag[movenbr])
+      WriteMoveNbr(si);
 
-  ++MoveNbr[nbply];
+    ++MoveNbr[nbply];
 
-  TraceValue("%u",nbply);
-  TraceValue("%u",MoveNbr[nbply]);
-  TraceValue("%u",RestartNbr[nbply]);
-  TraceEOL();
-  pipe_this_move_doesnt_solve_if(si,MoveNbr[nbply]<=RestartNbr[nbply]);
+    TraceValue("%u",nbply);
+    TraceValue("%u",MoveNbr[nbply]);
+    TraceValue("%u",RestartNbr[nbply]);
+    TraceEOL();
+    pipe_this_move_doesnt_solve_if(si,MoveNbr[nbply]<=RestartNbr[nbply]);
+
+    root_move_splitter_move_solved();
+  }
+  else
+    ++MoveNbr[nbply];
 
   MoveNbr[nbply+1] = 0;
 
@@ -194,6 +204,17 @@ static void insert_guard_attack(slice_index si, stip_structure_traversal *st)
   TraceFunctionParam("%u",si);
   TraceFunctionParamListEnd();
 
+  if (st->level==structure_traversal_level_top
+      && root_move_splitter_is_enabled())
+  {
+    slice_index const prototypes[] = {
+        alloc_root_move_splitter(),
+        alloc_pipe(STRestartGuard)
+    };
+    enum { nr_prototypes = sizeof prototypes / sizeof prototypes[0] };
+    slice_insertion_insert(si,prototypes,nr_prototypes);
+  }
+  else if (OptFlag[movenbr])
   {
     slice_index const prototype = alloc_pipe(STRestartGuard);
     slice_insertion_insert(si,&prototype,1);
@@ -235,7 +256,17 @@ static void insert_guard_help(slice_index si, stip_structure_traversal *st)
         };
         slice_insertion_insert(si,prototypes,3);
       }
-      else
+      else if (st->level==structure_traversal_level_top
+               && root_move_splitter_is_enabled())
+      {
+        slice_index const prototypes[] = {
+            alloc_root_move_splitter(),
+            alloc_pipe(STRestartGuard)
+        };
+        enum { nr_prototypes = sizeof prototypes / sizeof prototypes[0] };
+        slice_insertion_insert(si,prototypes,nr_prototypes);
+      }
+      else if (OptFlag[movenbr])
       {
         slice_index const prototype = alloc_pipe(STRestartGuard);
         slice_insertion_insert(si,&prototype,1);
@@ -244,12 +275,23 @@ static void insert_guard_help(slice_index si, stip_structure_traversal *st)
   }
   else
   {
-    slice_index const prototypes[] = {
-        alloc_restart_guard_intelligent(),
-        alloc_intelligent_target_counter()
-    };
-    enum { nr_prototypes = sizeof prototypes / sizeof prototypes[0] };
-    slice_insertion_insert(si,prototypes,nr_prototypes);
+    if (OptFlag[movenbr])
+    {
+      slice_index const prototype = alloc_restart_guard_intelligent();
+      slice_insertion_insert(si,&prototype,1);
+    }
+
+    if (root_move_splitter_is_enabled())
+    {
+      slice_index const prototype = alloc_intelligent_target_position_splitter();
+      slice_insertion_insert(si,&prototype,1);
+    }
+
+    if (OptFlag[movenbr] || root_move_splitter_is_enabled())
+    {
+      slice_index const prototype = alloc_intelligent_target_counter();
+      slice_insertion_insert(si,&prototype,1);
+    }
   }
 
   TraceFunctionExit(__func__);
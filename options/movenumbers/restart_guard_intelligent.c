@@ -5,6 +5,7 @@
 #include "solving/pipe.h"
 #include "debugging/trace.h"
 #include "options/movenumbers.h"
+#include "options/movenumbers/root_move_splitter.h"
 #include "optimisations/intelligent/moves_left.h"
 #include "platform/maxtime.h"
 #include "options/options.h"
@@ -142,7 +143,11 @@ void intelligent_target_counter_solve(slice_index si)
   TraceValue("%u",nr_potential_target_positions);
   TraceEOL();
 
-  pipe_solve_delegate(si);
+  if (root_move_splitter_is_move_ours())
+  {
+    pipe_solve_delegate(si);
+    root_move_splitter_move_solved();
+  }
 
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
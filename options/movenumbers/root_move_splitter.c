@@ -0,0 +1,268 @@
+#include "options/movenumbers/root_move_splitter.h"
+#include "stipulation/stipulation.h"
+#include "stipulation/pipe.h"
+#include "stipulation/structure_traversal.h"
+#include "solving/pipe.h"
+#include "solving/ply.h"
+#include "options/options.h"
+#include "solving/machinery/perft.h"
+#include "platform/worker.h"
+#include "debugging/trace.h"
+
+#include "debugging/assert.h"
+
+static unsigned int nr_workers;
+
+typedef enum
+{
+  splitter_idle,
+  splitter_armed,   /* waiting for the first move at the root level */
+  splitter_serial,  /* no worker could be started */
+  splitter_main,    /* collecting the results of the workers */
+  splitter_worker   /* solving the moves claimed */
+} splitter_state_type;
+
+static splitter_state_type state = splitter_idle;
+
+/* ply of the moves being distributed */
+static ply root_ply;
+
+/* number of the next move played at root_ply */
+static unsigned int next_task;
+
+/* number of the move claimed by this worker */
+static unsigned int claimed_task;
+
+/* Set the number of worker processes (-threads command line option)
+ * @param nr number of workers; 0 or 1 disable distributing the root moves
+ */
+void root_move_splitter_set_nr_workers(unsigned int nr)
+{
+  nr_workers = nr;
+}
+
+/* Are the moves at the root level to be distributed?
+ * @return true iff root move splitters are to be inserted
+ */
+boolean root_move_splitter_is_enabled(void)
+{
+  /* the workers can't share the solution and sequence counters */
+  return (nr_workers>1 && !OptFlag[maxsols] && !OptFlag[stoponshort]
+          && perft_depth==0);
+}
+
+/* Allocate a STRootMoveSplitter slice.
+ * @return allocated slice
+ */
+slice_index alloc_root_move_splitter(void)
+{
+  slice_index result;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  result = alloc_pipe(STRootMoveSplitter);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResult("%u",result);
+  TraceFunctionResultEnd();
+  return result;
+}
+
+/* Allocate a STIntelligentTargetPositionSplitter slice.
+ * @return allocated slice
+ */
+slice_index alloc_intelligent_target_position_splitter(void)
+{
+  slice_index result;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  result = alloc_pipe(STIntelligentTargetPositionSplitter);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResult("%u",result);
+  TraceFunctionResultEnd();
+  return result;
+}
+
+static void remove_splitter(slice_index si, stip_structure_traversal *st)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  stip_traverse_structure_children_pipe(si,st);
+  pipe_remove(si);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Remove the STRootMoveSplitter and STIntelligentTargetPositionSplitter
+ * slices from the solving machinery, e.g. because output is written to a
+ * medium whose contents can't be merged
+ * @param si identifies slice where to start
+ */
+void solving_remove_root_move_splitters(slice_index si)
+{
+  stip_structure_traversal st;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  stip_structure_traversal_init(&st,0);
+  stip_structure_traversal_override_single(&st,
+                                           STRootMoveSplitter,
+                                           &remove_splitter);
+  stip_structure_traversal_override_single(&st,
+                                           STIntelligentTargetPositionSplitter,
+                                           &remove_splitter);
+  stip_traverse_structure(si,&st);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+static void start_workers(void)
+{
+  unsigned int const worker = platform_start_workers(nr_workers);
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  root_ply = nbply;
+  next_task = 0;
+
+  if (worker>0)
+  {
+    state = splitter_worker;
+    claimed_task = platform_worker_claim_task();
+  }
+  else if (platform_get_nr_workers()>0)
+    state = splitter_main;
+  else
+    state = splitter_serial;
+
+  TraceValue("%u",state);
+  TraceEOL();
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Determine whether the move just played at the root level (or the target
+ * position just reached) is to be solved by the current process. To be called
+ * by STRestartGuard and STIntelligentTargetCounter.
+ * @return true iff the move is to be solved by the current process
+ * @note if the move isn't to be solved, assigns solve_result the result of
+ *       solving the move (which may have been done by a worker)
+ */
+boolean root_move_splitter_is_move_ours(void)
+{
+  boolean result = true;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  /* start the workers only now so that they inherit the generated moves
+   * (or the target position) */
+  if (state==splitter_armed)
+    start_workers();
+
+  if (nbply==root_ply)
+    switch (state)
+    {
+      case splitter_main:
+      {
+        unsigned int worker_result;
+        if (platform_collect_worker_task(next_task,&worker_result))
+        {
+          solve_result = worker_result;
+          result = false;
+        }
+        break;
+      }
+
+      case splitter_worker:
+        if (next_task==claimed_task)
+          platform_worker_begin_task(claimed_task);
+        else
+        {
+          solve_result = MOVE_HAS_NOT_SOLVED_LENGTH();
+          result = false;
+        }
+        break;
+
+      default:
+        break;
+    }
+
+  if (nbply==root_ply)
+    ++next_task;
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResult("%u",result);
+  TraceFunctionResultEnd();
+  return result;
+}
+
+/* Inform the root move splitter that the move just played (or the target
+ * position just reached) has been solved.
+ * To be called by STRestartGuard and STIntelligentTargetCounter.
+ */
+void root_move_splitter_move_solved(void)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  if (state==splitter_worker && nbply==root_ply)
+  {
+    platform_worker_end_task(claimed_task,solve_result);
+    claimed_task = platform_worker_claim_task();
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void root_move_splitter_solve(slice_index si)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  if (state==splitter_idle)
+  {
+    state = splitter_armed;
+
+    pipe_solve_delegate(si);
+
+    if (state==splitter_worker)
+      platform_worker_exit();
+    else if (state==splitter_main)
+      platform_stop_workers();
+
+    state = splitter_idle;
+  }
+  else
+    pipe_solve_delegate(si);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
@@ -0,0 +1,74 @@
+#if !defined(OPTIONS_MOVENUMBERS_ROOT_MOVE_SPLITTER_H)
+#define OPTIONS_MOVENUMBERS_ROOT_MOVE_SPLITTER_H
+
+#include "solving/machinery/solve.h"
+
+/* This module provides functionality dealing with STRootMoveSplitter
+ * stipulation slice type.
+ * Slices of this type distribute the moves at the root level over several
+ * worker processes (command line option -threads). The moves are numbered by
+ * the STRestartGuard slices, i.e. the same way as for option start.
+ * In intelligent mode, STIntelligentTargetPositionSplitter slices distribute
+ * the target positions the same way; they are numbered by the
+ * STIntelligentTargetCounter slices. A solution found in several target
+ * positions by different workers is written once.
+ */
+
+/* Set the number of worker processes (-threads command line option)
+ * @param nr number of workers; 0 or 1 disable distributing the root moves
+ */
+void root_move_splitter_set_nr_workers(unsigned int nr);
+
+/* Are the moves at the root level to be distributed?
+ * @return true iff root move splitters are to be inserted
+ */
+boolean root_move_splitter_is_enabled(void);
+
+/* Allocate a STRootMoveSplitter slice.
+ * @return allocated slice
+ */
+slice_index alloc_root_move_splitter(void);
+
+/* Allocate a STIntelligentTargetPositionSplitter slice.
+ * @return allocated slice
+ */
+slice_index alloc_intelligent_target_position_splitter(void);
+
+/* Remove the STRootMoveSplitter and STIntelligentTargetPositionSplitter
+ * slices from the solving machinery, e.g. because output is written to a
+ * medium whose contents can't be merged
+ * @param si identifies slice where to start
+ */
+void solving_remove_root_move_splitters(slice_index si);
+
+/* Determine whether the move just played at the root level (or the target
+ * position just reached) is to be solved by the current process. To be called
+ * by STRestartGuard and STIntelligentTargetCounter.
+ * @return true iff the move is to be solved by the current process
+ * @note if the move isn't to be solved, assigns solve_result the result of
+ *       solving the move (which may have been done by a worker)
+ */
+boolean root_move_splitter_is_move_ours(void);
+
+/* Inform the root move splitter that the move just played (or the target
+ * position just reached) has been solved.
+ * To be called by STRestartGuard and STIntelligentTargetCounter.
+ */
+void root_move_splitter_move_solved(void);
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void root_move_splitter_solve(slice_index si);
+
+#endif
@@ -42,8 +42,9 @@ typedef enum
   mutuallyexclusivecastling,     /* 32 */
   goal_is_end,     /* 33 */
   degeneratetree,  /* 34 */
+  proofnumbers,    /* 35 */
 
-  OptCount         /* 35 */
+  OptCount         /* 36 */
 } Opt;
 
 extern boolean OptFlag[OptCount];
@@ -22,6 +22,7 @@
 #include "conditions/grid.h"
 #include "conditions/singlebox/type1.h"
 #include "solving/incomplete.h"
+#include "options/movenumbers/root_move_splitter.h"
 #include "platform/tmpfile.h"
 #include "debugging/assert.h"
 
@@ -1202,10 +1203,20 @@ static void visit_output_mode_selector(slice_index si, stip_structure_traversal
   TraceFunctionParam("%u",si);
   TraceFunctionParamListEnd();
 
-  if (SLICE_U(si).output_mode_selector.mode==output_mode_line)
-    solving_insert_output_latex_line_slices(si,file);
-  else
-    solving_insert_output_latex_tree_slices(si,file);
+  switch (SLICE_U(si).output_mode_selector.mode)
+  {
+    case output_mode_line:
+      solving_insert_output_latex_line_slices(si,file);
+      break;
+
+    case output_mode_tree:
+      solving_insert_output_latex_tree_slices(si,file);
+      break;
+
+    default:
+      /* nothing is written */
+      break;
+  }
 
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
@@ -1235,6 +1246,9 @@ void output_latex_instrument_solving(slice_index si)
     stip_traverse_structure(si,&st);
   }
 
+  /* the workers' LaTeX output couldn't be merged */
+  solving_remove_root_move_splitters(si);
+
   pipe_solve_delegate(si);
 
   TraceFunctionExit(__func__);
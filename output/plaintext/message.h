@@ -11,6 +11,10 @@
  */
 void output_plaintext_suppress_variable(void);
 
+/* true iff output that is supposed to be different in two runs with the same
+ * input is suppressed */
+extern boolean is_variable_output_suppressed;
+
 /* Report a verification error that causes the current problem to be ignored
  * @param id identiifes the diagnostic message
  */
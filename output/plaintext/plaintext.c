@@ -817,10 +817,20 @@ static void visit_output_mode_selector(slice_index si, stip_structure_traversal
   TraceFunctionParam("%u",si);
   TraceFunctionParamListEnd();
 
-  if (SLICE_U(si).output_mode_selector.mode==output_mode_line)
-    solving_insert_output_plaintext_line_slices(si);
-  else
-    solving_insert_output_plaintext_tree_slices(si);
+  switch (SLICE_U(si).output_mode_selector.mode)
+  {
+    case output_mode_line:
+      solving_insert_output_plaintext_line_slices(si);
+      break;
+
+    case output_mode_tree:
+      solving_insert_output_plaintext_tree_slices(si);
+      break;
+
+    default:
+      /* nothing is written */
+      break;
+  }
 
   TraceFunctionExit(__func__);
   TraceFunctionResultEnd();
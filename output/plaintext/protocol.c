@@ -33,6 +33,15 @@ FILE *protocol_open(char const *filename)
   return TraceFile;
 }
 
+/* Stop writing to the protocol file without closing it.
+ * To be used by a process that shares the protocol file with the process that
+ * actually writes it.
+ */
+void protocol_detach(void)
+{
+  TraceFile = 0;
+}
+
 /* like putchar().
  * If a trace file is active, output goes to the trace file as well
  * @return the result of writing to *regular
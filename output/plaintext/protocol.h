@@ -19,6 +19,12 @@ void protocol_overwrite(void);
  */
 FILE *protocol_open(char const *filename);
 
+/* Stop writing to the protocol file without closing it.
+ * To be used by a process that shares the protocol file with the process that
+ * actually writes it.
+ */
+void protocol_detach(void);
+
 /* like putchar().
  * If a trace file is active, output goes to the trace file as well
  * @return the result of writing to *regular
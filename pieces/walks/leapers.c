@@ -10,9 +10,12 @@
 void leaper_generate_moves(vec_index_type kbeg, vec_index_type kend)
 {
   /* generate leaper moves from vec[kbeg] to vec[kend] */
+  square const sq_departure = curr_generation->departure;
   vec_index_type k;
 
-  for (k= kbeg; k<= kend; ++k)
+  for (k = first_vector_to_board(sq_departure,kbeg);
+       k<=kend;
+       k = first_vector_to_board(sq_departure,k+1))
   {
     curr_generation->arrival = curr_generation->departure+vec[k];
     if (is_square_empty(curr_generation->arrival)
@@ -35,9 +38,9 @@ boolean leapers_check(vec_index_type kanf, vec_index_type kend,
 
   ++observation_context;
 
-  for (interceptable_observation[observation_context].vector_index1 = kanf;
+  for (interceptable_observation[observation_context].vector_index1 = first_vector_to_board(sq_target,kanf);
        interceptable_observation[observation_context].vector_index1<=kend;
-       interceptable_observation[observation_context].vector_index1++)
+       interceptable_observation[observation_context].vector_index1 = first_vector_to_board(sq_target,interceptable_observation[observation_context].vector_index1+1))
   {
     square const sq_departure= sq_target+vec[interceptable_observation[observation_context].vector_index1];
     if (EVALUATE_OBSERVATION(evaluate,sq_departure,sq_target))
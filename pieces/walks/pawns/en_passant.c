@@ -431,6 +431,27 @@ boolean en_passant_is_ep_capture(square sq_capture)
   return result;
 }
 
+/* Remember the square passed over by the multistep move just played (if it
+ * was one) if the moving pawn can be captured en passant
+ */
+void en_passant_adjust(void)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  if (move_generation_stack[CURRMOVE_OF_PLY(nbply)].capture==pawn_multistep)
+  {
+    move_effect_journal_index_type const top = move_effect_journal_base[nbply];
+    move_effect_journal_index_type const movement = top+move_effect_journal_index_offset_movement;
+    square const multistep_over = en_passant_find_potential(move_effect_journal[movement].u.piece_movement.from);
+    if (multistep_over!=initsquare)
+      move_effect_journal_do_remember_ep(multistep_over);
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
 /* Try to solve in solve_nr_remaining half-moves.
  * @param si slice index
  * @note assigns solve_result the length of solution found and written, i.e.:
@@ -450,15 +471,7 @@ void en_passant_adjuster_solve(slice_index si)
   TraceFunctionParam("%u",si);
   TraceFunctionParamListEnd();
 
-  if (move_generation_stack[CURRMOVE_OF_PLY(nbply)].capture==pawn_multistep)
-  {
-    move_effect_journal_index_type const top = move_effect_journal_base[nbply];
-    move_effect_journal_index_type const movement = top+move_effect_journal_index_offset_movement;
-    square const multistep_over = en_passant_find_potential(move_effect_journal[movement].u.piece_movement.from);
-    if (multistep_over!=initsquare)
-      move_effect_journal_do_remember_ep(multistep_over);
-  }
-
+  en_passant_adjust();
   pipe_solve_delegate(si);
 
   TraceFunctionExit(__func__);
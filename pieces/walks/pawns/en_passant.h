@@ -136,6 +136,11 @@ square en_passant_find_potential(square sq_multistep_departure);
  */
 boolean en_passant_is_ep_capture(square sq_capture);
 
+/* Remember the square passed over by the multistep move just played (if it
+ * was one) if the moving pawn can be captured en passant
+ */
+void en_passant_adjust(void);
+
 /* Try to solve in solve_nr_remaining half-moves.
  * @param si slice index
  * @note assigns solve_result the length of solution found and written, i.e.:
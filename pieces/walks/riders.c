@@ -35,6 +35,7 @@ square generate_moves_on_line_segment(square sq_base, vec_index_type k)
 void rider_generate_moves(vec_index_type kbeg, vec_index_type kend)
 {
   /* generate rider moves from vec[kbeg] to vec[kend] */
+  square const sq_departure = curr_generation->departure;
   vec_index_type k;
 
   TraceFunctionEntry(__func__);
@@ -42,7 +43,10 @@ void rider_generate_moves(vec_index_type kbeg, vec_index_type kend)
   TraceFunctionParam("%u",kend);
   TraceFunctionParamListEnd();
 
-  for (k = kbeg; k<=kend; ++k)
+  /* lines leaving the board at the first step don't contain any move */
+  for (k = first_vector_to_board(sq_departure,kbeg);
+       k<=kend;
+       k = first_vector_to_board(sq_departure,k+1))
   {
     curr_generation->arrival = generate_moves_on_line_segment(curr_generation->departure,k);
     if (piece_belongs_to_opponent(curr_generation->arrival))
@@ -67,9 +71,9 @@ boolean riders_check(vec_index_type kanf, vec_index_type kend,
 
   TraceEnumerator(Side,trait[nbply]);
   TraceEOL();
-  for (interceptable_observation[observation_context].vector_index1 = kanf;
+  for (interceptable_observation[observation_context].vector_index1 = first_vector_to_board(sq_target,kanf);
        interceptable_observation[observation_context].vector_index1<= kend;
-       ++interceptable_observation[observation_context].vector_index1)
+       interceptable_observation[observation_context].vector_index1 = first_vector_to_board(sq_target,interceptable_observation[observation_context].vector_index1+1))
   {
     square const sq_departure = find_end_of_line(sq_target,vec[interceptable_observation[observation_context].vector_index1]);
     TraceSquare(sq_departure);
@@ -58,3 +58,38 @@ numvec vec[maxvec + 1] = { 0,
 /* 217 - 224 | 6,7 */  137,  162,  174,  151, -137, -162, -174, -151,
 /* 225 - 232 | 2,7 */   41,  166,  170,   55,  -41, -166, -170,  -55,
 };
+
+unsigned char vectors_to_board_row[maxsquare+5];
+unsigned char vectors_to_board[nr_squares_on_board+1][maxvec+2];
+
+/* Initialise the table of the vectors leading to the board
+ */
+void initialise_vectors_to_board(void)
+{
+  unsigned int const outside = nr_squares_on_board;
+  unsigned int i;
+  square s;
+  int k;
+
+  for (s = 0; s!=maxsquare+5; ++s)
+    vectors_to_board_row[s] = outside;
+
+  for (i = 0; i!=nr_squares_on_board; ++i)
+  {
+    square const sq = boardnum[i];
+    unsigned char next = maxvec+1;
+
+    vectors_to_board_row[sq] = i;
+
+    vectors_to_board[i][maxvec+1] = next;
+    for (k = maxvec; k>=0; --k)
+    {
+      if (k>0 && is_on_board(sq+vec[k]))
+        next = k;
+      vectors_to_board[i][k] = next;
+    }
+  }
+
+  for (k = 0; k<=maxvec+1; ++k)
+    vectors_to_board[outside][k] = k;
+}
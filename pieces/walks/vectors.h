@@ -61,5 +61,27 @@ typedef enum
   vec_leap27_start=225,           vec_leap27_end=  232
 } vec_index_type;
 
+/* The vectors leading from a square to the board. For each square of the board
+ * and each vector index k, the first vector index >=k whose vector leads from
+ * the square to a square of the board (maxvec+1 if there is none). All
+ * squares outside of the board share a row of the table where each vector
+ * index refers to itself.
+ */
+extern unsigned char vectors_to_board_row[];
+extern unsigned char vectors_to_board[][maxvec+2];
+
+/* Determine the first vector at or after a vector index that leads from a
+ * square to a square of the board
+ * @param sq square
+ * @param k vector index
+ * @return the vector index; maxvec+1 if there is none
+ */
+#define first_vector_to_board(sq,k) \
+  ((vec_index_type)vectors_to_board[vectors_to_board_row[(sq)]][(k)])
+
+/* Initialise the table of the vectors leading to the board
+ */
+void initialise_vectors_to_board(void);
+
 
 #endif
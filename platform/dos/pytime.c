@@ -94,3 +94,15 @@ void StopTimer(unsigned long *seconds, unsigned long *msec)
 }
 
 #endif /* !__GNUC__ */
+
+#include <time.h>
+
+unsigned long long platform_read_ticks(void)
+{
+  return (unsigned long long)clock();
+}
+
+unsigned long long platform_get_ticks_per_second(void)
+{
+  return (unsigned long long)CLOCKS_PER_SEC;
+}
@@ -4,6 +4,8 @@
 #include "utilities/boolean.h"
 #include "stipulation/stipulation.h"
 
+#include <stddef.h>
+
 typedef unsigned long maxmem_kilos_type;
 
 extern maxmem_kilos_type const one_mega;
@@ -29,4 +31,57 @@ void hashtable_dimensioner_solve(slice_index si);
  */
 maxmem_kilos_type platform_get_allocated_memory(void);
 
+/* Ways of backing the memory of the hash tables; can be combined.
+ * Platforms ignore the ways that they don't support.
+ */
+enum
+{
+  memory_backing_huge_pages = 1u<<0,     /* use huge pages if available */
+  memory_backing_numa_interleave = 1u<<1, /* spread pages over all nodes */
+  memory_backing_numa_bind = 1u<<2,      /* keep pages on the current node */
+  memory_backing_prefault = 1u<<3        /* fault in pages at allocation */
+};
+
+/* Request a way of backing the memory of the hash tables
+ * Implemented separately for each platform.
+ * @param backing combination of memory_backing_* values
+ */
+void platform_request_memory_backing(unsigned int backing);
+
+/* Allocate memory for a hash table, backed as requested
+ * Implemented separately for each platform.
+ * @param size number of bytes to allocate
+ * @param is_shared true iff the memory is to be shared with the worker
+ *                  processes started afterwards
+ * @return address of the allocated memory, initialised to 0;
+ *         0 if the memory couldn't be allocated
+ */
+void *platform_allocate_table_memory(size_t size, boolean is_shared);
+
+/* Free memory allocated by platform_allocate_table_memory()
+ * Implemented separately for each platform.
+ * @param memory address of the memory
+ * @param size number of bytes allocated
+ */
+void platform_free_table_memory(void *memory, size_t size);
+
+/* Map a file into memory for holding a hash table; the contents of the
+ * memory survive the process in the file.
+ * Implemented separately for each platform.
+ * @param path path of the file; the file is created if it doesn't exist
+ * @param size number of bytes to map; the file is resized accordingly
+ * @param keep_contents false iff the file is to be filled with 0
+ * @return address of the mapped memory; 0 if the file couldn't be mapped
+ */
+void *platform_map_table_file(char const *path,
+                              size_t size,
+                              boolean keep_contents);
+
+/* Unmap memory mapped by platform_map_table_file()
+ * Implemented separately for each platform.
+ * @param memory address of the memory
+ * @param size number of bytes mapped
+ */
+void platform_unmap_table_file(void *memory, size_t size);
+
 #endif
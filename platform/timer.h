@@ -29,6 +29,18 @@ void StartTimer(void);
  */
 void StopTimer(unsigned long *seconds, unsigned long *msec);
 
+/* Read a clock that is fine-grained enough for measuring the time spent in
+ * individual slices (option -profile)
+ * @return number of ticks since an arbitrary moment
+ */
+unsigned long long platform_read_ticks(void);
+
+/* Determine the resolution of platform_read_ticks()
+ * @return number of ticks per second; 0 if the ticks are processor cycles,
+ *         whose frequency isn't known
+ */
+unsigned long long platform_get_ticks_per_second(void);
+
 void timer_starter_solve(slice_index si);
 
 #endif /* PYTIME_H */
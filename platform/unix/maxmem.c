@@ -1,11 +1,212 @@
+#if defined(__linux__)
+/* for MAP_HUGETLB, MADV_HUGEPAGE and syscall() */
+#define _GNU_SOURCE
+#endif
+
 #include "platform/maxmem.h"
 
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+
+/* from <linux/mempolicy.h> */
+enum
+{
+  mpol_bind = 2,
+  mpol_interleave = 3,
+  mpol_f_mems_allowed = 1<<2
+};
+#endif
+
 /* Make a guess for a reasonable amount of memory for the hashtable
  * @return number of kilo-bytes to be used
  */
 unsigned long platform_guess_reasonable_maxmemory(void)
 {
   unsigned long const one_giga = 1024*1024;
-  
+
   return one_giga;
 }
+
+static unsigned int requested_backing;
+
+/* Request a way of backing the memory of the hash tables
+ * @param backing combination of memory_backing_* values
+ */
+void platform_request_memory_backing(unsigned int backing)
+{
+  requested_backing = backing;
+}
+
+/* Determine the size of the mapping used for a memory block
+ * @param size size of the block
+ * @return size of the mapping
+ */
+static size_t mapping_size(size_t size)
+{
+  /* huge pages are mapped in units of 2 MB on most architectures */
+  size_t const unit = ((requested_backing&memory_backing_huge_pages)
+                       ? (size_t)2*1024*1024
+                       : (size_t)sysconf(_SC_PAGESIZE));
+
+  if (size==0)
+    return unit;
+  else if (size>((size_t)-1)-unit)
+    return size;
+  else
+    return (size+unit-1)/unit*unit;
+}
+
+static void *map_memory(size_t size, boolean is_shared)
+{
+  int const flags = is_shared ? MAP_SHARED : MAP_PRIVATE;
+  void *result = MAP_FAILED;
+
+#if defined(MAP_ANONYMOUS) && defined(MAP_HUGETLB)
+  if (requested_backing&memory_backing_huge_pages)
+    /* fails if the system hasn't reserved enough huge pages */
+    result = mmap(0,size,PROT_READ|PROT_WRITE,flags|MAP_ANONYMOUS|MAP_HUGETLB,-1,0);
+#endif
+
+  if (result==MAP_FAILED)
+  {
+    /* MAP_ANONYMOUS isn't POSIX; mapping /dev/zero has the same effect */
+    int const fd = open("/dev/zero",O_RDWR);
+    if (fd<0)
+      return 0;
+
+    result = mmap(0,size,PROT_READ|PROT_WRITE,flags,fd,0);
+    close(fd);
+
+    if (result==MAP_FAILED)
+      return 0;
+
+#if defined(MADV_HUGEPAGE)
+    if (requested_backing&memory_backing_huge_pages)
+      /* ask for transparent huge pages instead */
+      madvise(result,size,MADV_HUGEPAGE);
+#endif
+  }
+
+  return result;
+}
+
+static void apply_numa_policy(void *memory, size_t size)
+{
+#if defined(__linux__) && defined(SYS_mbind) && defined(SYS_get_mempolicy) && defined(SYS_getcpu)
+  enum { max_node = 1024 };
+  unsigned long nodes[max_node/(CHAR_BIT*sizeof(unsigned long))] = { 0 };
+
+  if (requested_backing&memory_backing_numa_bind)
+  {
+    unsigned int cpu;
+    unsigned int node;
+    if (syscall(SYS_getcpu,&cpu,&node,0)==0 && node<max_node)
+    {
+      nodes[node/(CHAR_BIT*sizeof nodes[0])] |= 1ul<<node%(CHAR_BIT*sizeof nodes[0]);
+      /* failure isn't fatal; the pages are then allocated as usual */
+      syscall(SYS_mbind,memory,size,mpol_bind,nodes,max_node,0);
+    }
+  }
+  else if (requested_backing&memory_backing_numa_interleave)
+  {
+    if (syscall(SYS_get_mempolicy,0,nodes,max_node,0,mpol_f_mems_allowed)==0)
+      syscall(SYS_mbind,memory,size,mpol_interleave,nodes,max_node,0);
+  }
+#endif
+}
+
+static void prefault(void *memory, size_t size)
+{
+  size_t const page_size = (size_t)sysconf(_SC_PAGESIZE);
+  char volatile *p = memory;
+  size_t i;
+
+  /* writing back what is there preserves the contents of mapped files */
+  for (i = 0; i<size; i += page_size)
+    p[i] = p[i];
+}
+
+/* Allocate memory for a hash table, backed as requested
+ * @param size number of bytes to allocate
+ * @param is_shared true iff the memory is to be shared with the worker
+ *                  processes started afterwards
+ * @return address of the allocated memory, initialised to 0;
+ *         0 if the memory couldn't be allocated
+ */
+void *platform_allocate_table_memory(size_t size, boolean is_shared)
+{
+  size_t const size_mapped = mapping_size(size);
+  void * const result = map_memory(size_mapped,is_shared);
+
+  if (result!=0)
+  {
+    apply_numa_policy(result,size_mapped);
+
+    if (requested_backing&memory_backing_prefault)
+      prefault(result,size_mapped);
+  }
+
+  return result;
+}
+
+/* Free memory allocated by platform_allocate_table_memory()
+ * @param memory address of the memory
+ * @param size number of bytes allocated
+ */
+void platform_free_table_memory(void *memory, size_t size)
+{
+  munmap(memory,mapping_size(size));
+}
+
+/* Map a file into memory for holding a hash table; the contents of the
+ * memory survive the process in the file.
+ * @param path path of the file; the file is created if it doesn't exist
+ * @param size number of bytes to map; the file is resized accordingly
+ * @param keep_contents false iff the file is to be filled with 0
+ * @return address of the mapped memory; 0 if the file couldn't be mapped
+ */
+void *platform_map_table_file(char const *path,
+                              size_t size,
+                              boolean keep_contents)
+{
+  void *result = MAP_FAILED;
+  int const fd = open(path,O_RDWR|O_CREAT,0666);
+
+  if (fd>=0)
+  {
+    /* truncating the file first makes the new size consist of 0 bytes */
+    if ((keep_contents || ftruncate(fd,0)==0)
+        && ftruncate(fd,(off_t)size)==0)
+      /* MAP_SHARED both writes the table to the file and shares it with the
+       * worker processes */
+      result = mmap(0,size,PROT_READ|PROT_WRITE,MAP_SHARED,fd,0);
+
+    close(fd);
+  }
+
+  if (result==MAP_FAILED)
+    return 0;
+  else
+  {
+    apply_numa_policy(result,size);
+
+    if (requested_backing&memory_backing_prefault)
+      prefault(result,size);
+
+    return result;
+  }
+}
+
+/* Unmap memory mapped by platform_map_table_file()
+ * @param memory address of the memory
+ * @param size number of bytes mapped
+ */
+void platform_unmap_table_file(void *memory, size_t size)
+{
+  munmap(memory,size);
+}
@@ -1,3 +1,6 @@
+/* for clock_gettime() */
+#define _POSIX_C_SOURCE 199309L
+
 #include "platform/timer.h"
 #include <time.h>
 
@@ -28,3 +31,30 @@ void StopTimer(unsigned long *seconds, unsigned long *msec)
 
   *seconds = stopTime-startTime;
 }
+
+unsigned long long platform_read_ticks(void)
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  /* processor cycles; much cheaper to read than any clock */
+  return __builtin_ia32_rdtsc();
+#elif defined(CLOCK_MONOTONIC)
+  struct timespec now;
+  if (clock_gettime(CLOCK_MONOTONIC,&now)==0)
+    return (unsigned long long)now.tv_sec*1000000000ull + (unsigned long long)now.tv_nsec;
+  else
+    return 0;
+#else
+  return (unsigned long long)clock();
+#endif
+}
+
+unsigned long long platform_get_ticks_per_second(void)
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  return 0;
+#elif defined(CLOCK_MONOTONIC)
+  return 1000000000ull;
+#else
+  return (unsigned long long)CLOCKS_PER_SEC;
+#endif
+}
@@ -0,0 +1,597 @@
+/* fork(), pread() etc. aren't part of C99 */
+#define _POSIX_C_SOURCE 200809L
+
+#include "platform/worker.h"
+#include "platform/tmpfile.h"
+#include "platform/maxtime.h"
+#include "output/plaintext/protocol.h"
+#include "debugging/assert.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+enum
+{
+  max_nr_workers = 64,
+  max_nr_tasks = 1<<14
+};
+
+/* characters delimiting an output item in the output of a worker */
+enum
+{
+  output_item_begin = '\001',
+  output_item_end = '\002'
+};
+
+typedef enum
+{
+  task_pending,
+  task_done
+} task_state_type;
+
+typedef struct
+{
+    unsigned int volatile state;
+    unsigned int worker;
+    off_t output_begin;
+    off_t output_end;
+    unsigned int result;
+} task_type;
+
+/* the tasks table is shared by all processes; task t uses the slot
+ * t%max_nr_tasks, which becomes available for task t+max_nr_tasks once the
+ * main process has collected task t */
+typedef struct
+{
+    unsigned int volatile next_unclaimed;
+    unsigned int volatile nr_collected;
+    task_type tasks[max_nr_tasks];
+} task_table_type;
+
+static task_table_type *task_table;
+static FILE *task_table_file;
+
+static pid_t worker_pid[max_nr_workers];
+static FILE *worker_output[max_nr_workers];
+static unsigned int nr_workers;
+
+/* index of the current process in worker_pid; 0 in the main process */
+static unsigned int this_worker;
+
+/* the process that has started the workers */
+static pid_t main_pid;
+
+/* output items already written by the main process since the workers were
+ * started */
+typedef struct
+{
+    unsigned long hash;
+    size_t length;
+    char *text;
+} output_item_type;
+
+static output_item_type *written_items;
+static unsigned int nr_written_items;
+static unsigned int nr_allocated_items;
+
+/* the output item being copied */
+static char *item_buffer;
+static size_t item_length;
+static size_t item_capacity;
+static boolean is_copying_item;
+
+/* each worker writes a byte to this pipe whenever it has completed a task */
+static int notification_pipe[2] = { -1, -1 };
+
+static boolean maxtime_forwarded;
+static boolean is_exit_handler_registered;
+
+static boolean create_task_table(void)
+{
+  task_table_file = platform_open_tmpfile();
+  if (task_table_file==0)
+    return false;
+  else if (ftruncate(fileno(task_table_file),sizeof *task_table)!=0)
+  {
+    platform_close_tmpfile(task_table_file);
+    task_table_file = 0;
+    return false;
+  }
+  else
+  {
+    void * const mapped = mmap(0,sizeof *task_table,
+                               PROT_READ|PROT_WRITE,MAP_SHARED,
+                               fileno(task_table_file),0);
+    if (mapped==MAP_FAILED)
+    {
+      platform_close_tmpfile(task_table_file);
+      task_table_file = 0;
+      return false;
+    }
+    else
+    {
+      /* the file is freshly truncated, i.e. all tasks are task_pending */
+      task_table = mapped;
+      return true;
+    }
+  }
+}
+
+static void delete_task_table(void)
+{
+  munmap(task_table,sizeof *task_table);
+  task_table = 0;
+  platform_close_tmpfile(task_table_file);
+  task_table_file = 0;
+}
+
+static void kill_workers(void)
+{
+  unsigned int i;
+
+  for (i = 0; i!=nr_workers; ++i)
+    kill(worker_pid[i],SIGKILL);
+
+  for (i = 0; i!=nr_workers; ++i)
+  {
+    while (waitpid(worker_pid[i],0,0)==-1 && errno==EINTR)
+    {
+    }
+    platform_close_tmpfile(worker_output[i]);
+  }
+
+  nr_workers = 0;
+}
+
+/* make sure that no worker survives the main process */
+static void kill_workers_at_exit(void)
+{
+  if (this_worker==0)
+    kill_workers();
+}
+
+static void forget_written_items(void)
+{
+  unsigned int i;
+
+  for (i = 0; i!=nr_written_items; ++i)
+    free(written_items[i].text);
+
+  free(written_items);
+  written_items = 0;
+  nr_written_items = 0;
+  nr_allocated_items = 0;
+
+  free(item_buffer);
+  item_buffer = 0;
+  item_length = 0;
+  item_capacity = 0;
+  is_copying_item = false;
+}
+
+static void become_worker(unsigned int worker)
+{
+  close(notification_pipe[0]);
+  notification_pipe[0] = -1;
+
+  /* everything that the worker writes to stdout ends up in its output file */
+  dup2(fileno(worker_output[worker]),STDOUT_FILENO);
+  protocol_detach();
+
+  this_worker = worker+1;
+  nr_workers = 0;
+}
+
+/* Start worker processes
+ * @param nr_workers number of workers requested
+ * @return 0 in the main process (even if no worker could be started);
+ *         1..nr_workers in the worker processes
+ */
+unsigned int platform_start_workers(unsigned int nr_requested)
+{
+  assert(nr_workers==0);
+
+  if (nr_requested>max_nr_workers)
+    nr_requested = max_nr_workers;
+
+  if (!create_task_table())
+    return 0;
+
+  if (pipe(notification_pipe)!=0)
+  {
+    delete_task_table();
+    return 0;
+  }
+
+  if (!is_exit_handler_registered)
+  {
+    atexit(&kill_workers_at_exit);
+    is_exit_handler_registered = true;
+  }
+
+  maxtime_forwarded = false;
+  main_pid = getpid();
+
+  /* don't let the workers inherit buffered output */
+  fflush(0);
+
+  while (nr_workers<nr_requested)
+  {
+    worker_output[nr_workers] = platform_open_tmpfile();
+    if (worker_output[nr_workers]==0)
+      break;
+    else
+    {
+      pid_t const pid = fork();
+      if (pid==0)
+      {
+        become_worker(nr_workers);
+        return this_worker;
+      }
+      else if (pid<0)
+      {
+        platform_close_tmpfile(worker_output[nr_workers]);
+        break;
+      }
+      else
+      {
+        worker_pid[nr_workers] = pid;
+        ++nr_workers;
+      }
+    }
+  }
+
+  close(notification_pipe[1]);
+  notification_pipe[1] = -1;
+
+  if (nr_workers==0)
+  {
+    close(notification_pipe[0]);
+    notification_pipe[0] = -1;
+    delete_task_table();
+  }
+
+  return 0;
+}
+
+/* Determine the number of workers started by platform_start_workers()
+ * @return number of workers; 0 if no worker is active
+ */
+unsigned int platform_get_nr_workers(void)
+{
+  return nr_workers;
+}
+
+static unsigned long hash_item(void)
+{
+  unsigned long result = 5381;
+  size_t i;
+
+  for (i = 0; i!=item_length; ++i)
+    result = result*33 + (unsigned char)item_buffer[i];
+
+  return result;
+}
+
+static boolean is_item_written(unsigned long hash)
+{
+  unsigned int i;
+
+  for (i = 0; i!=nr_written_items; ++i)
+    if (written_items[i].hash==hash
+        && written_items[i].length==item_length
+        && memcmp(written_items[i].text,item_buffer,item_length)==0)
+      return true;
+
+  return false;
+}
+
+/* Write the output item just copied unless it has already been written for an
+ * earlier task */
+static void write_item(void)
+{
+  unsigned long const hash = hash_item();
+
+  is_copying_item = false;
+
+  if (!is_item_written(hash))
+  {
+    protocol_fprintf(stdout,"%.*s",(int)item_length,item_buffer);
+
+    if (nr_written_items==nr_allocated_items)
+    {
+      unsigned int const nr_allocated = nr_allocated_items==0 ? 64 : 2*nr_allocated_items;
+      output_item_type * const allocated = realloc(written_items,
+                                                   nr_allocated * sizeof *allocated);
+      if (allocated!=0)
+      {
+        written_items = allocated;
+        nr_allocated_items = nr_allocated;
+      }
+    }
+
+    if (nr_written_items<nr_allocated_items)
+    {
+      /* the item's text now belongs to written_items */
+      written_items[nr_written_items].hash = hash;
+      written_items[nr_written_items].length = item_length;
+      written_items[nr_written_items].text = item_buffer;
+      ++nr_written_items;
+      item_buffer = 0;
+      item_capacity = 0;
+    }
+  }
+
+  item_length = 0;
+}
+
+static void copy_output_segment(char const *text, size_t length)
+{
+  if (is_copying_item && item_length+length>item_capacity)
+  {
+    size_t const capacity = 2*(item_length+length);
+    char * const allocated = realloc(item_buffer,capacity);
+    if (allocated==0)
+      /* give up avoiding to write this item twice */
+      write_item();
+    else
+    {
+      item_buffer = allocated;
+      item_capacity = capacity;
+    }
+  }
+
+  if (is_copying_item)
+  {
+    memcpy(item_buffer+item_length,text,length);
+    item_length += length;
+  }
+  else if (length>0)
+    protocol_fprintf(stdout,"%.*s",(int)length,text);
+}
+
+static void copy_output(char const *text, size_t length)
+{
+  size_t begin = 0;
+  size_t i;
+
+  for (i = 0; i!=length; ++i)
+    if (text[i]==output_item_begin || text[i]==output_item_end)
+    {
+      copy_output_segment(text+begin,i-begin);
+      if (text[i]==output_item_begin)
+        is_copying_item = true;
+      else if (is_copying_item)
+        write_item();
+      begin = i+1;
+    }
+
+  copy_output_segment(text+begin,length-begin);
+}
+
+static void copy_task_output(task_type const *task)
+{
+  int const fd = fileno(worker_output[task->worker-1]);
+  off_t pos = task->output_begin;
+
+  while (pos<task->output_end)
+  {
+    char buffer[4096];
+    size_t const wanted = (task->output_end-pos<(off_t)sizeof buffer
+                           ? (size_t)(task->output_end-pos)
+                           : sizeof buffer);
+    ssize_t const nr_read = pread(fd,buffer,wanted,pos);
+    if (nr_read<=0)
+      break;
+    else
+    {
+      copy_output(buffer,(size_t)nr_read);
+      pos += nr_read;
+    }
+  }
+
+  /* an item doesn't extend over the end of a task */
+  if (is_copying_item)
+    write_item();
+}
+
+static void forward_maxtime(void)
+{
+  if (!maxtime_forwarded && platform_has_maxtime_elapsed())
+  {
+    unsigned int i;
+    for (i = 0; i!=nr_workers; ++i)
+      kill(worker_pid[i],SIGALRM);
+    maxtime_forwarded = true;
+  }
+}
+
+/* Wait until there is news from the workers
+ * @return false iff all workers have terminated
+ */
+static boolean wait_for_notification(void)
+{
+  struct pollfd pfd;
+  pfd.fd = notification_pipe[0];
+  pfd.events = POLLIN;
+
+  /* time out regularly to be able to forward the maxtime signal; the signal
+   * doesn't reliably interrupt poll() */
+  if (poll(&pfd,1,1000)>0)
+  {
+    char buffer[64];
+    /* all workers have closed the pipe iff read() returns 0 */
+    if (read(notification_pipe[0],buffer,sizeof buffer)==0)
+      return false;
+  }
+
+  forward_maxtime();
+
+  return true;
+}
+
+/* Wait for a worker to complete a task, then write the output that the worker
+ * has written while solving the task
+ * @param task identifies the task
+ * @param result where to store the result of solving the task
+ * @return true iff the task has been completed by a worker;
+ *         false if the main process has to solve the task itself
+ */
+boolean platform_collect_worker_task(unsigned int task, unsigned int *result)
+{
+  if (nr_workers==0)
+    return false;
+  else
+  {
+    task_type * const slot = &task_table->tasks[task%max_nr_tasks];
+
+    while (slot->state!=task_done)
+      if (!wait_for_notification())
+      {
+        /* the worker that claimed the task has died prematurely */
+        if (slot->state!=task_done)
+          return false;
+      }
+
+    __sync_synchronize();
+
+    copy_task_output(slot);
+    *result = slot->result;
+
+    /* make the slot available to task+max_nr_tasks */
+    slot->state = task_pending;
+    __sync_synchronize();
+    task_table->nr_collected = task+1;
+
+    return true;
+  }
+}
+
+/* Stop all workers and release the resources used for distributing tasks
+ */
+void platform_stop_workers(void)
+{
+  if (nr_workers>0)
+  {
+    kill_workers();
+    close(notification_pipe[0]);
+    notification_pipe[0] = -1;
+    delete_task_table();
+    forget_written_items();
+  }
+}
+
+/* Claim the next task not yet claimed by any worker (worker process only)
+ * @return identifier of the claimed task; no_worker_task if none is left
+ */
+unsigned int platform_worker_claim_task(void)
+{
+  unsigned int const result = __sync_fetch_and_add(&task_table->next_unclaimed,1);
+
+  /* wait until the slot of the task is available */
+  while (result-task_table->nr_collected>=max_nr_tasks)
+    if (getppid()!=main_pid)
+      /* the main process has gone */
+      _exit(1);
+    else
+      poll(0,0,1);
+
+  return result;
+}
+
+/* Start solving a claimed task (worker process only)
+ * @param task identifies the task
+ */
+void platform_worker_begin_task(unsigned int task)
+{
+  task_type * const slot = &task_table->tasks[task%max_nr_tasks];
+
+  fflush(stdout);
+  slot->worker = this_worker;
+  slot->output_begin = lseek(STDOUT_FILENO,0,SEEK_CUR);
+}
+
+/* Report the completion of a task (worker process only)
+ * @param task identifies the task
+ * @param result result of solving the task
+ */
+void platform_worker_end_task(unsigned int task, unsigned int result)
+{
+  task_type * const slot = &task_table->tasks[task%max_nr_tasks];
+
+  fflush(stdout);
+  slot->output_end = lseek(STDOUT_FILENO,0,SEEK_CUR);
+  slot->result = result;
+
+  __sync_synchronize();
+  slot->state = task_done;
+
+  if (write(notification_pipe[1],"",1)!=1)
+  {
+    /* the main process has gone */
+    _exit(1);
+  }
+}
+
+/* Start an output item (worker process only)
+ */
+void platform_worker_begin_output_item(void)
+{
+  if (this_worker>0)
+    fputc(output_item_begin,stdout);
+}
+
+/* End the output item started by platform_worker_begin_output_item() (worker
+ * process only)
+ */
+void platform_worker_end_output_item(void)
+{
+  if (this_worker>0)
+    fputc(output_item_end,stdout);
+}
+
+/* Terminate a worker process once it has run out of tasks
+ */
+void platform_worker_exit(void)
+{
+  fflush(stdout);
+  _exit(0);
+}
+
+/* Allocate memory that the main process shares with the workers started
+ * afterwards
+ * @param size number of bytes to allocate
+ * @return address of the allocated memory, initialised to 0;
+ *         0 if the memory couldn't be allocated
+ */
+void *platform_allocate_shared_memory(size_t size)
+{
+  /* MAP_ANONYMOUS isn't POSIX; mapping /dev/zero has the same effect */
+  int const fd = open("/dev/zero",O_RDWR);
+  if (fd==-1)
+    return 0;
+  else
+  {
+    void * const result = mmap(0,size,PROT_READ|PROT_WRITE,MAP_SHARED,fd,0);
+    close(fd);
+    return result==MAP_FAILED ? 0 : result;
+  }
+}
+
+/* Free memory allocated by platform_allocate_shared_memory()
+ * @param memory address of the memory
+ * @param size number of bytes allocated
+ */
+void platform_free_shared_memory(void *memory, size_t size)
+{
+  munmap(memory,size);
+}
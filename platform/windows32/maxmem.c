@@ -1,4 +1,5 @@
 #include "platform/maxmem.h"
+#include <stdlib.h>
 #include <limits.h>
 #include <windows.h>
 
@@ -41,3 +42,56 @@ unsigned long platform_guess_reasonable_maxmemory(void)
 
   return result;
 }
+
+/* Request a way of backing the memory of the hash tables
+ * @param backing combination of memory_backing_* values
+ * @note this platform only supports the default backing
+ */
+void platform_request_memory_backing(unsigned int backing)
+{
+  /* intentionally nothing */
+}
+
+/* Allocate memory for a hash table, backed as requested
+ * @param size number of bytes to allocate
+ * @param is_shared true iff the memory is to be shared with the worker
+ *                  processes started afterwards
+ * @return address of the allocated memory, initialised to 0;
+ *         0 if the memory couldn't be allocated
+ */
+void *platform_allocate_table_memory(size_t size, boolean is_shared)
+{
+  /* there are no worker processes on this platform */
+  return calloc(1,size==0 ? 1 : size);
+}
+
+/* Free memory allocated by platform_allocate_table_memory()
+ * @param memory address of the memory
+ * @param size number of bytes allocated
+ */
+void platform_free_table_memory(void *memory, size_t size)
+{
+  free(memory);
+}
+
+/* Map a file into memory for holding a hash table
+ * @param path path of the file
+ * @param size number of bytes to map
+ * @param keep_contents false iff the file is to be filled with 0
+ * @return address of the mapped memory; 0 if the file couldn't be mapped
+ */
+void *platform_map_table_file(char const *path,
+                              size_t size,
+                              boolean keep_contents)
+{
+  /* not supported on this platform; the table is held in memory instead */
+  return 0;
+}
+
+/* Unmap memory mapped by platform_map_table_file()
+ * @param memory address of the memory
+ * @param size number of bytes mapped
+ */
+void platform_unmap_table_file(void *memory, size_t size)
+{
+}
@@ -28,3 +28,13 @@ void StopTimer(unsigned long *seconds, unsigned long *msec)
 
   *seconds = (unsigned long)(stopTime-startTime);
 }
+
+unsigned long long platform_read_ticks(void)
+{
+  return (unsigned long long)clock();
+}
+
+unsigned long long platform_get_ticks_per_second(void)
+{
+  return (unsigned long long)CLOCKS_PER_SEC;
+}
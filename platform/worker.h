@@ -0,0 +1,93 @@
+#if !defined(PLATFORM_WORKER_H)
+#define PLATFORM_WORKER_H
+
+#include "utilities/boolean.h"
+
+#include <limits.h>
+#include <stddef.h>
+
+/* Functions for distributing the moves of a move loop over several worker
+ * processes.
+ *
+ * Each worker is a copy of Popeye's process created at the moment the
+ * distribution starts. The moves of the loop are numbered (tasks) in the
+ * order in which they are played; every process plays all the moves, but only
+ * solves the tasks that it has claimed. The output written while a worker
+ * solves a task is captured, and the main process writes it in task order.
+ * An output item (e.g. a solution) that has already been written for an
+ * earlier task since the workers have been started isn't written again.
+ */
+
+/* value returned by platform_worker_claim_task() if there is no task left
+ * that a worker may claim */
+#define no_worker_task UINT_MAX
+
+/* Start worker processes
+ * @param nr_workers number of workers requested
+ * @return 0 in the main process (even if no worker could be started);
+ *         1..nr_workers in the worker processes
+ */
+unsigned int platform_start_workers(unsigned int nr_workers);
+
+/* Determine the number of workers started by platform_start_workers()
+ * @return number of workers; 0 if no worker is active
+ */
+unsigned int platform_get_nr_workers(void);
+
+/* Wait for a worker to complete a task, then write the output that the worker
+ * has written while solving the task
+ * @param task identifies the task
+ * @param result where to store the result of solving the task
+ * @return true iff the task has been completed by a worker;
+ *         false if the main process has to solve the task itself
+ */
+boolean platform_collect_worker_task(unsigned int task, unsigned int *result);
+
+/* Stop all workers and release the resources used for distributing tasks
+ */
+void platform_stop_workers(void);
+
+/* Claim the next task not yet claimed by any worker (worker process only)
+ * @return identifier of the claimed task; no_worker_task if none is left
+ */
+unsigned int platform_worker_claim_task(void);
+
+/* Start solving a claimed task (worker process only)
+ * @param task identifies the task
+ */
+void platform_worker_begin_task(unsigned int task);
+
+/* Report the completion of a task (worker process only)
+ * @param task identifies the task
+ * @param result result of solving the task
+ */
+void platform_worker_end_task(unsigned int task, unsigned int result);
+
+/* Start an output item (worker process only)
+ */
+void platform_worker_begin_output_item(void);
+
+/* End the output item started by platform_worker_begin_output_item() (worker
+ * process only)
+ */
+void platform_worker_end_output_item(void);
+
+/* Terminate a worker process once it has run out of tasks
+ */
+void platform_worker_exit(void);
+
+/* Allocate memory that the main process shares with the workers started
+ * afterwards
+ * @param size number of bytes to allocate
+ * @return address of the allocated memory, initialised to 0;
+ *         0 if the memory couldn't be allocated
+ */
+void *platform_allocate_shared_memory(size_t size);
+
+/* Free memory allocated by platform_allocate_shared_memory()
+ * @param memory address of the memory
+ * @param size number of bytes allocated
+ */
+void platform_free_shared_memory(void *memory, size_t size);
+
+#endif
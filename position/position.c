@@ -31,6 +31,153 @@ Side const PAS_sides[nr_squares_on_board] = {
     Black,   Black,   Black,   Black, Black,   Black,   Black,   Black
   };
 
+/* Spread the bits of a value over a hash key (finaliser of splitmix64)
+ * @param value value to be mixed
+ * @return hash key
+ */
+position_hash_key_type mix_hash_key(position_hash_key_type value)
+{
+  value ^= value>>30;
+  value *= 0xbf58476d1ce4e5b9ull;
+  value ^= value>>27;
+  value *= 0x94d049bb133111ebull;
+  value ^= value>>31;
+
+  return value;
+}
+
+/* Determine the contribution of a piece to the hash key of a position.
+ * Piece ids are ignored, i.e. pieces that only differ in their ids contribute
+ * the same.
+ * @param s square where the piece stands
+ * @param walk walk of the piece
+ * @param flags flags of the piece
+ * @return the contribution; 0 for an empty square
+ */
+static position_hash_key_type piece_hash_key(square s,
+                                             piece_walk_type walk,
+                                             Flags flags)
+{
+  if (walk==Empty)
+    return 0;
+  else
+    return mix_hash_key(((position_hash_key_type)walk<<48)
+                        ^ ((position_hash_key_type)(flags&PieSpMask)<<16)
+                        ^ (position_hash_key_type)s);
+}
+
+/* Calculate the hash key of a position from scratch. To be invoked after
+ * the board or specs of a position have been modified without using the
+ * functions below.
+ * @param pos address of position object
+ */
+void calculate_position_hash_key(position *pos)
+{
+  enum { nr_squares = sizeof pos->board / sizeof pos->board[0] };
+  unsigned int i;
+
+  pos->hash_key = 0;
+  for (i = 0; i!=nr_squares; ++i)
+    pos->hash_key ^= piece_hash_key(i,pos->board[i],pos->spec[i]);
+
+  pos->occupied[White] = 0;
+  pos->occupied[Black] = 0;
+  pos->non_empty = 0;
+  for (i = 0; i<=Bishop; ++i)
+    pos->occupied_by_walk[i] = 0;
+
+  for (i = 0; i!=nr_squares_on_board; ++i)
+  {
+    square const s = boardnum[i];
+    square_set_type const element = (square_set_type)1<<i;
+
+    if (TSTFLAG(pos->spec[s],White))
+      pos->occupied[White] |= element;
+    if (TSTFLAG(pos->spec[s],Black))
+      pos->occupied[Black] |= element;
+    if (pos->board[s]!=Empty)
+      pos->non_empty |= element;
+    if (pos->board[s]>=King && pos->board[s]<=Bishop)
+      pos->occupied_by_walk[pos->board[s]] |= element;
+  }
+}
+
+/* Remove the first square (in the order of boardnum) from a set of squares
+ * @param set address of the set; must not be empty
+ * @return the square removed
+ */
+square square_set_pop_first(square_set_type *set)
+{
+  unsigned int index;
+
+  assert(*set!=0);
+
+#if defined(__GNUC__)
+  index = (unsigned int)__builtin_ctzll(*set);
+#else
+  for (index = 0; (*set&((square_set_type)1<<index))==0; ++index)
+    ;
+#endif
+
+  *set &= *set-1;
+
+  return boardnum[index];
+}
+
+/* Determine the index of the bit representing a square in a set of squares
+ * @param s square on the board
+ * @return the index, i.e. i with boardnum[i]==s
+ */
+unsigned int square_set_index(square s)
+{
+  assert(is_on_board(s));
+  return (unsigned int)((s/onerow-bottom_row)*nr_files_on_board
+                        + s%onerow-left_file);
+}
+
+/* Remove the contents of a square from the sets of squares
+ * @param s square; the sets don't represent squares outside of the board
+ */
+static void remove_from_square_sets(square s)
+{
+  if (is_on_board(s))
+  {
+    square_set_type const others = ~square_set_element(s);
+    Flags const spec = being_solved.spec[s];
+    piece_walk_type const walk = being_solved.board[s];
+
+    if (TSTFLAG(spec,White))
+      being_solved.occupied[White] &= others;
+    if (TSTFLAG(spec,Black))
+      being_solved.occupied[Black] &= others;
+    being_solved.non_empty &= others;
+    if (walk>=King && walk<=Bishop)
+      being_solved.occupied_by_walk[walk] &= others;
+  }
+}
+
+/* Add the contents of a square to the sets of squares
+ * @param s square; the sets don't represent squares outside of the board
+ */
+static void add_to_square_sets(square s)
+{
+  if (is_on_board(s))
+  {
+    square_set_type const element = square_set_element(s);
+    Flags const spec = being_solved.spec[s];
+    piece_walk_type const walk = being_solved.board[s];
+
+    if (TSTFLAG(spec,White))
+      being_solved.occupied[White] |= element;
+    if (TSTFLAG(spec,Black))
+      being_solved.occupied[Black] |= element;
+    if (walk!=Empty)
+      being_solved.non_empty |= element;
+    if (walk>=King && walk<=Bishop)
+      being_solved.occupied_by_walk[walk] |= element;
+  }
+}
+
 void initialise_game_array(position *pos)
 {
   unsigned int i;
@@ -90,6 +237,8 @@ void initialise_game_array(position *pos)
     pos->isquare[i] = initsquare;
 
   pos->castling_rights = wh_castlings|bl_castlings;
+
+  calculate_position_hash_key(pos);
 }
 
 /* Swap the sides of all the pieces */
@@ -107,6 +256,8 @@ void swap_sides(void)
         && !is_square_blocked(*bnp))
       piece_change_side(&being_solved.spec[*bnp]);
 
+  calculate_position_hash_key(&being_solved);
+
   {
     piece_walk_type walk;
     for (walk = Empty; walk!=nr_piece_walks; ++walk)
@@ -149,6 +300,8 @@ void reflect_position(void)
     being_solved.spec[*bnp] = sp;
   }
 
+  calculate_position_hash_key(&being_solved);
+
   swap_castling_rights();
 
   isBoardReflected = !isBoardReflected;
@@ -164,6 +317,10 @@ void piece_change_side(Flags *spec)
 
 void empty_square(square s)
 {
+  being_solved.hash_key ^= piece_hash_key(s,
+                                          being_solved.board[s],
+                                          being_solved.spec[s]);
+  remove_from_square_sets(s);
   being_solved.board[s] = Empty;
   being_solved.spec[s] = EmptySpec;
 }
@@ -172,22 +329,56 @@ void occupy_square(square s, piece_walk_type walk, Flags flags)
 {
   assert(walk!=Empty);
   assert(walk!=Invalid);
+  being_solved.hash_key ^= (piece_hash_key(s,
+                                           being_solved.board[s],
+                                           being_solved.spec[s])
+                            ^ piece_hash_key(s,walk,flags));
+  remove_from_square_sets(s);
   being_solved.board[s] = walk;
   being_solved.spec[s] = flags;
+  add_to_square_sets(s);
 }
 
 void replace_walk(square s, piece_walk_type walk)
 {
   assert(walk!=Empty);
   assert(walk!=Invalid);
+  being_solved.hash_key ^= (piece_hash_key(s,
+                                           being_solved.board[s],
+                                           being_solved.spec[s])
+                            ^ piece_hash_key(s,walk,being_solved.spec[s]));
+  remove_from_square_sets(s);
   being_solved.board[s] = walk;
+  add_to_square_sets(s);
+}
+
+/* Change the flags of the contents of a square without changing its walk;
+ * the square may be empty or even off the board (e.g. a royal square that
+ * has been left), in which case the sets of squares aren't touched
+ * @param s square
+ * @param flags new flags
+ */
+void replace_flags(square s, Flags flags)
+{
+  piece_walk_type const walk = being_solved.board[s];
+  being_solved.hash_key ^= (piece_hash_key(s,walk,being_solved.spec[s])
+                            ^ piece_hash_key(s,walk,flags));
+  remove_from_square_sets(s);
+  being_solved.spec[s] = flags;
+  add_to_square_sets(s);
 }
 
 void block_square(square s)
 {
   assert(is_square_empty(s) || is_square_blocked(s));
+  being_solved.hash_key ^= (piece_hash_key(s,
+                                           being_solved.board[s],
+                                           being_solved.spec[s])
+                            ^ piece_hash_key(s,Invalid,BorderSpec));
+  remove_from_square_sets(s);
   being_solved.board[s] = Invalid;
   being_solved.spec[s] = BorderSpec;
+  add_to_square_sets(s);
 }
 
 square find_end_of_line(square from, numvec dir)
@@ -37,6 +37,16 @@ enum
 
 typedef square imarr[maxinum]; /* squares currently occupied by imitators */
 
+/* Zobrist style key of the contents of the board; the key of a position is
+ * the xor of the keys of the pieces on its squares
+ */
+typedef unsigned long long position_hash_key_type;
+
+/* Set of squares of the board; square boardnum[i] is represented by bit i,
+ * so that iterating over a set visits the squares in the order of boardnum
+ */
+typedef unsigned long long square_set_type;
+
 /* Structure containing the pieces of data that together represent a
  * position.
  */
@@ -50,6 +60,13 @@ typedef struct position
     unsigned int number_of_pieces[nr_sides][nr_piece_walks]; /* number of piece kind */
     castling_rights_type castling_rights;
     PieceIdType currPieceId;
+    position_hash_key_type hash_key;     /* key of board and spec */
+    square_set_type occupied[nr_sides];  /* squares occupied by each side's
+                                          * pieces, including neutral ones */
+    square_set_type non_empty;           /* squares occupied or blocked */
+    square_set_type occupied_by_walk[Bishop+1]; /* squares occupied by the
+                                                 * orthodox walks King..Bishop
+                                                 * of either side */
 } position;
 
 extern position being_solved;
@@ -70,6 +87,52 @@ extern position const game_array;
  */
 void initialise_game_array(position *pos);
 
+/* Spread the bits of a value over a hash key (finaliser of splitmix64)
+ * @param value value to be mixed
+ * @return hash key
+ */
+position_hash_key_type mix_hash_key(position_hash_key_type value);
+
+/* Calculate the hash key and the sets of squares of a position from
+ * scratch. To be invoked after the board or specs of a position have been
+ * modified without using the functions below.
+ * @param pos address of position object
+ */
+void calculate_position_hash_key(position *pos);
+
+/* Determine the index of the bit representing a square in a set of squares
+ * @param s square on the board
+ * @return the index, i.e. i with boardnum[i]==s
+ */
+unsigned int square_set_index(square s);
+
+/* Determine the element of a set of squares representing a square
+ * @param s square on the board
+ * @return the element
+ */
+#define square_set_element(s) ((square_set_type)1<<square_set_index(s))
+
+/* Remove the first square (in the order of boardnum) from a set of squares
+ * @param set address of the set; must not be empty
+ * @return the square removed
+ */
+square square_set_pop_first(square_set_type *set);
+
+/* Determine the set of squares occupied by the pieces of a side
+ * @param side the side
+ * @return the set
+ */
+#define get_squares_occupied_by(side) (being_solved.occupied[(side)])
+
+/* Determine the set of squares occupied by the pieces of a side with an
+ * orthodox walk
+ * @param side the side
+ * @param walk one of King..Bishop
+ * @return the set
+ */
+#define get_squares_occupied_by_walk(side,walk) \
+  (being_solved.occupied[(side)] & being_solved.occupied_by_walk[(walk)])
+
 /* Swap the sides of all the pieces */
 void swap_sides(void);
 
@@ -80,6 +143,7 @@ void empty_square(square s);
 void block_square(square s);
 void occupy_square(square s, piece_walk_type walk, Flags flags);
 void replace_walk(square s, piece_walk_type walk);
+void replace_flags(square s, Flags flags);
 #define is_square_empty(s) (being_solved.board[(s)]==Empty)
 #define is_square_blocked(s) (being_solved.board[(s)]==Invalid)
 #define get_walk_of_piece_on_square(s) (being_solved.board[(s)])
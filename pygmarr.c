@@ -87,4 +87,17 @@ position const game_array =
   },
   0x77 /* castling_rights */
   , 0 /* currPieceId */
+  , 0x54c4943e8fb63ceeull /* hash_key */
+  , { 0xffffull, 0xffff000000000000ull } /* occupied */
+  , 0xffff00000000ffffull /* non_empty */
+  , { /* occupied_by_walk */
+      0x0ull
+      , 0x0ull
+      , 0x1000000000000010ull
+      , 0xff00000000ff00ull
+      , 0x800000000000008ull
+      , 0x4200000000000042ull
+      , 0x8100000000000081ull
+      , 0x2400000000000024ull
+    }
 };
@@ -1,5 +1,6 @@
 #include "optimisations/hash.h"
 #include "solving/moves_traversal.h"
+#include "solving/machinery/dispatch.h"
 #include "output/plaintext/language_dependant.h"
 #include "output/latex/latex.h"
 #include "platform/priority.h"
@@ -45,6 +46,7 @@ int main(int argc, char *argv[])
   initialise_slice_properties();
   init_structure_children_visitors();
   init_moves_children_visitors();
+  init_dispatch_table();
 
   {
     slice_index const parser = alloc_command_line_options_parser(argc,argv);
@@ -0,0 +1,154 @@
+#! /bin/bash
+
+# Script for checking command line options that must not change the
+# solutions: the test files are solved with the options, and the output
+# is compared to that stored in ../REGRESSIONTESTS. The totals of -perft
+# are compared to the numbers known for some positions.
+#
+# Run from the directory that is to contain the Popeye output.
+#
+# The counters written by executables compiled with DOMEASURE depend on
+# the options and are ignored.
+#
+# The exit status is the number of checks that failed.
+#
+# Uses: mktemp, diff, ls, wc, sed, grep, python3 (optional)
+
+SCRIPTDIR=$(dirname $0)
+POPEYEDIR=${SCRIPTDIR}/..
+
+_cmd="${POPEYEDIR}/py -maxmem 1G -maxtrace 0 -regression"
+
+nrfailures=0
+
+tmpdir=$(mktemp -d)
+trap "rm -rf $tmpdir" EXIT
+
+# Remove the counters and empty lines from a file of Popeye output
+# Usage: withoutcounters <file>
+withoutcounters()
+{
+    sed -E 's/(^| +)[A-Za-z_]+: +[0-9]+$//' $1 | grep -v '^ *$'
+}
+
+# Solve a test file with some command line options and compare the output
+# Usage: check <testfile> <option>...
+check()
+{
+    testfile=$1
+    shift
+    outputfile=$(basename $testfile .inp).tst
+
+    rm -f $outputfile
+    $_cmd "$@" ${POPEYEDIR}/TESTS/$testfile > /dev/null 2>&1
+
+    withoutcounters $outputfile > $tmpdir/actual 2> /dev/null
+    withoutcounters ${POPEYEDIR}/REGRESSIONTESTS/$outputfile > $tmpdir/expected
+    if [ -s $tmpdir/actual ] && diff -q -wb $tmpdir/actual $tmpdir/expected > /dev/null
+    then
+        echo "ok:     $testfile $*"
+    else
+        echo "FAILED: $testfile $*"
+        nrfailures=$((nrfailures+1))
+    fi
+}
+
+# -hashfile: the first run writes a file per problem, the second run takes
+# the positions over from the files
+mkdir $tmpdir/hash
+check hashfile.inp -hashfile $tmpdir/hash/hashfile
+check hashfile.inp -hashfile $tmpdir/hash/hashfile
+if [ $(ls $tmpdir/hash | wc -l) -ne 2 ]
+then
+    echo "FAILED: hashfile.inp -hashfile: problems share a file"
+    nrfailures=$((nrfailures+1))
+fi
+
+# -memorymode: modes that the system doesn't support are ignored
+check battle_play.inp -maxmem 64M -memorymode huge,interleave
+check help_play.inp -maxmem 64M -memorymode bind,prefault
+check help_play.inp -maxmem 64M -memorymode huge,prefault -hashreplace
+
+# -hashreplace: in the small table, new positions replace stored ones
+check battle_play.inp -hashreplace
+check help_play.inp -hashreplace
+check battle_play.inp -hashreplace -maxmem 256K
+check series_play.inp -hashreplace -maxmem 256K
+
+# -hashkeep: the table is kept from twins that only differ by their
+# positions, and emptied when the stipulation or a condition changes
+check genf.inp -hashkeep
+check pieces.inp -hashkeep
+check proofnumbers.inp -hashkeep
+check circe.inp -hashkeep
+check help_play.inp -hashkeep
+check pieces.inp -hashkeep -hashreplace
+
+# -profile: the profile is written to a JSON file
+check battle_play.inp -profile $tmpdir/profile.json
+check pieces.inp -profile $tmpdir/profile_twins.json
+for profile in $tmpdir/profile.json $tmpdir/profile_twins.json
+do
+    if [ ! -s $profile ]
+    then
+        echo "FAILED: -profile: $(basename $profile) not written"
+        nrfailures=$((nrfailures+1))
+    elif type python3 > /dev/null 2>&1 \
+         && ! python3 -m json.tool $profile > /dev/null 2>&1
+    then
+        echo "FAILED: -profile: $(basename $profile) isn't well-formed JSON"
+        nrfailures=$((nrfailures+1))
+    fi
+done
+
+# -perft: the totals are compared to the well-known numbers of sequences
+# Usage: checkperft <depth> <expected total> (reads the problem from stdin)
+checkperft()
+{
+    cat > $tmpdir/perft.inp
+    total=$(${POPEYEDIR}/py -maxmem 1G -perft $1 $tmpdir/perft.inp 2> /dev/null \
+            | grep "^perft $1:")
+    if [ "$total" = "perft $1: $2" ]
+    then
+        echo "ok:     -perft $1: $2"
+    else
+        echo "FAILED: -perft $1: $2 expected, got $total"
+        nrfailures=$((nrfailures+1))
+    fi
+}
+
+# initial position
+checkperft 4 197281 <<END
+beginproblem
+stipulation ~1
+pieces white ke1 qd1 ra1h1 bc1f1 sb1g1 pa2b2c2d2e2f2g2h2
+       black ke8 qd8 ra8h8 bc8f8 sb8g8 pa7b7c7d7e7f7g7h7
+endproblem
+END
+
+# castlings, promotions and en passant captures
+checkperft 3 97862 <<END
+beginproblem
+stipulation ~1
+pieces white ke1 qf3 ra1h1 bd2e2 sc3e5 pa2b2c2d5e4f2g2h2
+       black ke8 qe7 ra8h8 ba6g7 sb6f6 pa7c7d7e6f7g6b4h3
+endproblem
+END
+
+# checks and pins along ranks
+checkperft 4 43238 <<END
+beginproblem
+stipulation ~1
+pieces white ka5 rb4 pb5e2g2
+       black kh4 rh5 pc7d6f4
+endproblem
+END
+
+# -threads: the moves at the root level (in intelligent mode: the target
+# positions) are distributed over worker processes
+check battle_play.inp -threads 2
+check help_play.inp -threads 2
+check series_play.inp -threads 2
+check intell.inp -threads 2
+
+exit $nrfailures
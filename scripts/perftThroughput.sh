@@ -0,0 +1,52 @@
+#! /bin/bash
+
+# Helper script for comparing the node throughput of Popeye executables,
+# e.g. before and after a change to the solving machinery
+#
+# Usage: perftThroughput.sh <depth> <nrofruns> <executable>...
+#
+# Each executable counts the sequences of <depth> legal moves from the
+# initial position (command line option -perft) <nrofruns> times. The
+# number of sequences, the lowest user time and the resulting number of
+# sequences per second are printed for each executable.
+#
+# Uses: mktemp, time, grep, awk
+
+depth=$1
+nrofruns=$2
+shift 2
+
+if [ -z "$depth" ] || [ -z "$nrofruns" ] || [ $# -eq 0 ]
+then
+    echo "Usage: $0 <depth> <nrofruns> <executable>..."
+    exit 1
+fi
+
+inputfile=$(mktemp)
+trap "rm -f $inputfile" EXIT
+
+cat > $inputfile <<END
+beginproblem
+stipulation ~1
+pieces white ke1 qd1 ra1h1 bc1f1 sb1g1 pa2b2c2d2e2f2g2h2
+       black ke8 qd8 ra8h8 bc8f8 sb8g8 pa7b7c7d7e7f7g7h7
+endproblem
+END
+
+TIMEFORMAT=%U
+
+for executable in "$@"
+do
+    for ((i=1; $i<=$nrofruns; i=$((i+1))))
+    do
+        { time $executable -maxmem 250M -perft $depth $inputfile | grep "^perft"; } 2>&1
+    done \
+    | awk -v executable="$executable" '
+        /^perft/ { sequences = $3; next }
+        { if (best=="" || $1<best) best = $1 }
+        END {
+          if (best>0)
+            printf "%s: %s sequences in %.3fs user time, %.0f sequences per second\n",
+                   executable, sequences, best, sequences/best
+        }'
+done
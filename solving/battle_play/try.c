@@ -78,6 +78,15 @@ void set_max_nr_refutations(unsigned int mnr)
   TraceFunctionResultEnd();
 }
 
+/* Retrieve the maximum number of refutations that the user is interested
+ * to see
+ * @return the number
+ */
+unsigned int get_max_nr_refutations(void)
+{
+  return user_set_max_nr_refutations;
+}
+
 /* Allocate a STRefutationsAllocator defender slice.
  * @return index of allocated slice
  */
@@ -26,6 +26,12 @@ boolean read_max_nr_refutations(char const *tok);
  */
 void set_max_nr_refutations(unsigned int mnr);
 
+/* Retrieve the maximum number of refutations that the user is interested
+ * to see
+ * @return the number
+ */
+unsigned int get_max_nr_refutations(void);
+
 /* Allocate a STRefutationsAllocator defender slice.
  * @return index of allocated slice
  */
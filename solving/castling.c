@@ -329,8 +329,9 @@ void disable_castling_rights(move_effect_reason_type reason,
 }
 
 /* Remove the castling rights according to the current move
+ * @param trait_ply side that has played the move
  */
-static void adjust_castling_rights(Side trait_ply)
+void adjust_castling_rights(Side trait_ply)
 {
   move_effect_journal_index_type const top = move_effect_journal_base[nbply+1];
   move_effect_journal_index_type curr;
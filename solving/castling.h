@@ -53,6 +53,11 @@ void enable_castling_rights(move_effect_reason_type reason,
 void disable_castling_rights(move_effect_reason_type reason,
                              square sq_departure);
 
+/* Remove the castling rights according to the current move
+ * @param trait_ply side that has played the move
+ */
+void adjust_castling_rights(Side trait_ply);
+
 /* Try to solve in solve_nr_remaining half-moves.
  * @param si slice index
  * @note assigns solve_result the length of solution found and written, i.e.:
@@ -164,8 +164,11 @@
 #include "optimisations/killer_move/collector.h"
 #include "optimisations/killer_move/final_defense_move.h"
 #include "optimisations/killer_move/prioriser.h"
+#include "optimisations/killer_move/history.h"
 #include "optimisations/orthodox_mating_moves/orthodox_mating_move_generator.h"
 #include "optimisations/orthodox_mating_moves/king_contact_move_generator.h"
+#include "optimisations/orthodox_pins.h"
+#include "optimisations/proof_numbers.h"
 #include "optimisations/orthodox_square_observation.h"
 #include "optimisations/ohneschach/non_checking_first.h"
 #include "optimisations/ohneschach/stop_if_check.h"
@@ -181,6 +184,7 @@
 #include "options/maxflightsquares.h"
 #include "options/maxsolutions/maxsolutions.h"
 #include "options/movenumbers/restart_guard_intelligent.h"
+#include "options/movenumbers/root_move_splitter.h"
 #include "options/no_short_variations/no_short_variations_attacker_filter.h"
 #include "options/stoponshortsolutions/stoponshortsolutions.h"
 #include "options/stoponshortsolutions/filter.h"
@@ -247,6 +251,7 @@
 #include "pieces/walks/pawns/promotion.h"
 #include "retro/retro.h"
 #include "stipulation/proxy.h"
+#include "stipulation/filter_fusion.h"
 #include "stipulation/whitetoplay.h"
 #include "stipulation/battle_play/branch.h"
 #include "solving/machinery/slack_length.h"
@@ -322,2075 +327,648 @@
 #include "solving/machinery/solvers.h"
 #include "solving/zeroposition.h"
 #include "debugging/trace.h"
+#include "solving/machinery/profile.h"
+#include "solving/machinery/perft.h"
 #include "debugging/measure.h"
 #include "debugging/assert.h"
 #include "platform/platform.h"
 #include "platform/maxmem.h"
 #include "platform/timer.h"
 
-/* Try to solve in solve_nr_remaining half-moves.
- * @param si slice index
- * @note assigns solve_result the length of solution found and written, i.e.:
- *            previous_move_is_illegal the move just played is illegal
- *            this_move_is_illegal     the move being played is illegal
- *            immobility_on_next_move  the moves just played led to an
- *                                     unintended immobility on the next move
- *            <=n+1 length of shortest solution found (n+1 only if in next
- *                                     branch)
- *            n+2 no solution found in this branch
- *            n+3 no solution found in next branch
- *            (with n denominating solve_nr_remaining)
- */
-void dispatch(slice_index si)
-{
-  TraceEnumerator(slice_type,SLICE_TYPE(si));
-  TraceEOL();
-
-  switch (SLICE_TYPE(si))
-  {
-    case STQuodlibetStipulationModifier:
-      quodlibet_stipulation_modifier_solve(si);
-      break;
-
-    case STGoalIsEndStipulationModifier:
-      goal_is_end_stipulation_modifier_solve(si);
-      break;
-
-    case STWhiteToPlayStipulationModifier:
-      white_to_play_stipulation_modifier_solve(si);
-      break;
-
-    case STPostKeyPlayStipulationModifier:
-      post_key_play_stipulation_modifier_solve(si);
-      break;
-
-    case STStipulationStarterDetector:
-      stipulation_starter_detector_solve(si);
-      break;
-
-    case STStipulationCopier:
-      stipulation_copier_solve(si);
-      break;
-
-    case STProofSolverBuilder:
-      build_proof_solving_machinery(si);
-      break;
-
-    case STAToBSolverBuilder:
-      build_atob_solving_machinery(si);
-      break;
-
-    case STTwinIdAdjuster:
-      twin_id_adjuster_solve(si);
-      break;
-
-    case STConditionsResetter:
-      conditions_resetter_solve(si);
-      break;
-
-    case STOptionsResetter:
-      options_resetter_solve(si);
-      break;
-
-    case STProblemSolvingIncomplete:
-      problem_solving_incomplete_solve(si);
-      break;
-
-    case STPhaseSolvingIncomplete:
-      phase_solving_incomplete_solve(si);
-      break;
-
-    case STCommandLineOptionsParser:
-      command_line_options_parser_solve(si);
-      break;
-
-    case STInputPlainTextOpener:
-      input_plaintext_opener_solve(si);
-      break;
-
-    case STPlatformInitialiser:
-      platform_initialiser_solve(si);
-      break;
-
-    case STOutputLaTeXCloser:
-      output_latex_closer_solve(si);
-      break;
-
-    case STOutputPlainTextInstrumentSolversBuilder:
-      output_plaintext_instrument_solving_builder_solve(si);
-      break;
-
-    case STOutputPlainTextInstrumentSolvers:
-      output_plaintext_instrument_solving(si);
-      break;
-
-    case STOutputLaTeXInstrumentSolversBuilder:
-      output_latex_instrument_solving_builder_solve(si);
-      break;
-
-    case STOutputLaTeXInstrumentSolvers:
-      output_latex_instrument_solving(si);
-      break;
-
-    case STHashTableDimensioner:
-      hashtable_dimensioner_solve(si);
-      break;
-
-    case STTimerStarter:
-      timer_starter_solve(si);
-      break;
-
-    case STCheckDirInitialiser:
-      check_dir_initialiser_solve(si);
-      break;
-
-    case STOutputPlainTextWriter:
-      output_plaintext_writer_solve(si);
-      break;
-
-    case STInputPlainTextUserLanguageDetector:
-      input_plaintext_detect_user_language(si);
-      break;
-
-    case STInputPlainTextProblemsIterator:
-      input_plaintext_iterate_problems(si);
-      break;
-
-    case STEndOfStipulationSpecific:
-    case STOutputPlainTextStartOfTargetWriter:
-      pipe_solve_delegate(si);
-      break;
-
-    case STInputPlainTextProblemHandler:
-      input_plaintext_problem_handle(si);
-      break;
-
-    case STInputPlainTextInitialTwinReader:
-      input_plaintext_initial_twin_reader_solve(si);
-      break;
-
-    case STInputPlainTextTwinsHandler:
-      input_plaintext_twins_handle(si);
-      break;
-
-    case STSolvingMachineryIntroBuilder:
-      solving_machinery_intro_builder_solve(si);
-      break;
-
-    case STOutputPlainTextOptionNoboard:
-      output_plaintext_option_noboard_solve(si);
-      break;
-
-    case STOutputPlaintextTwinIntroWriterBuilder:
-      output_plaintext_twin_intro_writer_builder_solve(si);
-      break;
-
-    case STOutputLaTeXTwinningWriterBuilder:
-      output_latex_twinning_writer_builder_solve(si);
-      break;
-
-    case STStartOfCurrentTwin:
-      slices_deallocator_solve(si);
-      break;
-
-    case STDuplexSolver:
-      duplex_solve(si);
-      break;
-
-    case STHalfDuplexSolver:
-      half_duplex_solve(si);
-      break;
-
-    case STCreateBuilderSetupPly:
-      create_builder_setup_ply_solve(si);
-      break;
-
-    case STPieceWalkCacheInitialiser:
-      piece_walk_caches_initialiser_solve(si);
-      break;
-
-    case STPiecesCounter:
-    {
-      void pieces_counter_solve(slice_index si);
-      pieces_counter_solve(si);
-      break;
-    }
-
-    case STPiecesFlagsInitialiser:
-    {
-      void initialise_piece_flags_solve(slice_index si);
-      initialise_piece_flags_solve(si);
-      break;
-    }
-
-    case STRoyalsLocator:
-    {
-      void royals_locator_solve(slice_index si);
-      royals_locator_solve(si);
-      break;
-    }
-
-    case STProofgameVerifyUniqueGoal:
-      proof_verify_unique_goal_solve(si);
-      break;
-
-    case STProofgameStartPositionInitialiser:
-      proof_initialise_start_position(si);
-      break;
-
-    case STProofSolver:
-      proof_solve(si);
-      break;
+typedef void (*solver_type)(slice_index si);
 
-    case STInputVerification:
-    {
-      void verify_position(slice_index si);
-      verify_position(si);
-      break;
-    }
+void pieces_counter_solve(slice_index si);
+void initialise_piece_flags_solve(slice_index si);
+void royals_locator_solve(slice_index si);
+void verify_position(slice_index si);
 
-    case STMoveEffectsJournalReset:
-      move_effect_journal_reset(si);
-      break;
-
-    case STSolversBuilder1:
-      build_solvers1(si);
-      break;
-
-    case STSolversBuilder2:
-      build_solvers2(si);
-      break;
-
-    case STProxyResolver:
-      proxies_resolve(si);
-      break;
-
-    case STSlackLengthAdjuster:
-      adjust_slack_length(si);
-      break;
-
-    case STThreatSolver:
-      threat_solver_solve(si);
-      break;
-
-    case STDummyMove:
-      dummy_move_solve(si);
-      break;
-
-    case STThreatCollector:
-      threat_collector_solve(si);
-      break;
-
-    case STThreatEnforcer:
-      threat_enforcer_solve(si);
-      break;
-
-    case STThreatDefeatedTester:
-      threat_defeated_tester_solve(si);
-      break;
-
-    case STOutputPlainTextThreatWriter:
-      output_plaintext_tree_threat_writer_solve(si);
-      break;
-
-    case STOutputPlainTextZugzwangByDummyMoveCheckWriter:
-      output_plaintext_tree_zugzwang_by_dummy_move_check_writer_solve(si);
-      break;
-
-    case STOutputPlainTextZugzwangWriter:
-      output_plaintext_tree_zugzwang_writer_solve(si);
-      break;
-
-    case STOutputPlainTextKeyWriter:
-      output_plaintext_tree_key_writer_solve(si);
-      break;
-
-    case STOutputPlainTextTryWriter:
-      output_plaintext_tree_try_writer_solve(si);
-      break;
-
-    case STRefutationsAllocator:
-      refutations_allocator_solve(si);
-      break;
-
-    case STRefutationsSolver:
-      refutations_solver_solve(si);
-      break;
-
-    case STOutputPlainTextRefutationsIntroWriter:
-      output_plaintext_tree_refutations_intro_writer_solve(si);
-      break;
-
-    case STRefutationsAvoider:
-      refutations_avoider_solve(si);
-      break;
-
-    case STRefutationsFilter:
-      refutations_filter_solve(si);
-      break;
-
-    case STOutputPlaintextTreeRefutingVariationWriter:
-      output_plaintext_tree_refuting_variation_writer_solve(si);
-      break;
-
-    case STOutputPlaintextLineRefutingVariationWriter:
-      output_plaintext_line_refuting_variation_writer_solve(si);
-      break;
-
-    case STOutputPlainTextMoveWriter:
-      output_plaintext_tree_move_writer_solve(si);
-      break;
-
-    case STTrivialEndFilter:
-      trivial_end_filter_solve(si);
-      break;
-
-    case STNoShortVariations:
-      no_short_variations_solve(si);
-      break;
-
-    case STOr:
-      or_solve(si);
-      break;
-
-    case STFindShortest:
-      find_shortest_solve(si);
-      break;
-
-    case STMoveGenerator:
-      move_generator_solve(si);
-      break;
-
-    case STForEachAttack:
-      for_each_attack_solve(si);
-      break;
-
-    case STFindAttack:
-      find_attack_solve(si);
-      break;
-
-    case STForEachDefense:
-      for_each_defense_solve(si);
-      break;
-
-    case STFindDefense:
-      find_defense_solve(si);
-      break;
-
-    case STNullMovePlayer:
-      null_move_player_solve(si);
-      break;
-
-    case STPostMoveIterationInitialiser:
-      move_execution_post_move_iterator_solve(si);
-      break;
-
-    case STMoveEffectJournalUndoer:
-      move_effect_journal_undoer_solve(si);
-      break;
-
-    case STMessignyMovePlayer:
-      messigny_move_player_solve(si);
-      break;
-
-    case STCastlingPlayer:
-      castling_player_solve(si);
-      break;
-
-    case STMovePlayer:
-      move_player_solve(si);
-      break;
-
-    case STEnPassantAdjuster:
-      en_passant_adjuster_solve(si);
-      break;
-
-    case STEinsteinEnPassantAdjuster:
-      einstein_en_passant_adjuster_solve(si);
-      break;
-
-    case STPawnPromoter:
-      pawn_promoter_solve(si);
-      break;
-
-    case STMarsCirceMoveToRebirthSquare:
-      marscirce_move_to_rebirth_square_solve(si);
-      break;
-
-    case STKamikazeCapturingPieceRemover:
-      kamikaze_capturing_piece_remover_solve(si);
-      break;
-
-    case STHaanChessHoleInserter:
-      haan_chess_hole_inserter_solve(si);
-      break;
-
-    case STCastlingChessMovePlayer:
-      castling_chess_move_player_solve(si);
-      break;
-
-    case STExchangeCastlingMovePlayer:
-      exchange_castling_move_player_solve(si);
-      break;
-
-    case STSuperTransmutingKingTransmuter:
-      supertransmuting_kings_transmuter_solve(si);
-      break;
-
-    case STSuperTransmutingKingMoveGenerationFilter:
-      supertransmuting_kings_move_generation_filter_solve(si);
-      break;
-
-    case STAMUAttackCounter:
-      amu_attack_counter_solve(si);
-      break;
-
-    case STMutualCastlingRightsAdjuster:
-      mutual_castling_rights_adjuster_solve(si);
-      break;
-
-    case STImitatorMover:
-      imitator_mover_solve(si);
-      break;
+static void true_solve(slice_index si)
+{
+  solve_result = previous_move_has_solved;
+}
 
-    case STImitatorRemoveIllegalMoves:
-      imitator_remove_illegal_moves_solve(si);
-      break;
+static void false_solve(slice_index si)
+{
+  solve_result = MOVE_HAS_NOT_SOLVED_LENGTH();
+}
 
-    case STImitatorDetectIllegalMoves:
-      imitator_detect_illegal_moves_solve(si);
-      break;
+static void generate_moves_for_piece_based_on_walk_solve(slice_index si)
+{
+  generate_moves_for_piece_based_on_walk();
+}
 
-    case STPawnToImitatorPromoter:
-      imitator_pawn_promoter_solve(si);
-      break;
+static void is_square_observed_ortho_solve(slice_index si)
+{
+  observation_result = is_square_observed_ortho(trait[nbply],
+                                                move_generation_stack[CURRMOVE_OF_PLY(nbply)].capture);
+}
 
-    case STAttackPlayed:
-      attack_played_solve(si);
-      break;
+/* the function implementing each slice type */
+static struct
+{
+    slice_type type;
+    solver_type solver;
+} const solvers[] =
+{
+  { STQuodlibetStipulationModifier, &quodlibet_stipulation_modifier_solve },
+  { STGoalIsEndStipulationModifier, &goal_is_end_stipulation_modifier_solve },
+  { STWhiteToPlayStipulationModifier, &white_to_play_stipulation_modifier_solve },
+  { STPostKeyPlayStipulationModifier, &post_key_play_stipulation_modifier_solve },
+  { STStipulationStarterDetector, &stipulation_starter_detector_solve },
+  { STStipulationCopier, &stipulation_copier_solve },
+  { STProofSolverBuilder, &build_proof_solving_machinery },
+  { STAToBSolverBuilder, &build_atob_solving_machinery },
+  { STTwinIdAdjuster, &twin_id_adjuster_solve },
+  { STConditionsResetter, &conditions_resetter_solve },
+  { STOptionsResetter, &options_resetter_solve },
+  { STProblemSolvingIncomplete, &problem_solving_incomplete_solve },
+  { STPhaseSolvingIncomplete, &phase_solving_incomplete_solve },
+  { STCommandLineOptionsParser, &command_line_options_parser_solve },
+  { STInputPlainTextOpener, &input_plaintext_opener_solve },
+  { STPlatformInitialiser, &platform_initialiser_solve },
+  { STOutputLaTeXCloser, &output_latex_closer_solve },
+  { STOutputPlainTextInstrumentSolversBuilder, &output_plaintext_instrument_solving_builder_solve },
+  { STOutputPlainTextInstrumentSolvers, &output_plaintext_instrument_solving },
+  { STOutputLaTeXInstrumentSolversBuilder, &output_latex_instrument_solving_builder_solve },
+  { STOutputLaTeXInstrumentSolvers, &output_latex_instrument_solving },
+  { STHashTableDimensioner, &hashtable_dimensioner_solve },
+  { STTimerStarter, &timer_starter_solve },
+  { STCheckDirInitialiser, &check_dir_initialiser_solve },
+  { STOutputPlainTextWriter, &output_plaintext_writer_solve },
+  { STInputPlainTextUserLanguageDetector, &input_plaintext_detect_user_language },
+  { STInputPlainTextProblemsIterator, &input_plaintext_iterate_problems },
+  { STEndOfStipulationSpecific, &pipe_solve_delegate },
+  { STOutputPlainTextStartOfTargetWriter, &pipe_solve_delegate },
+  { STInputPlainTextProblemHandler, &input_plaintext_problem_handle },
+  { STInputPlainTextInitialTwinReader, &input_plaintext_initial_twin_reader_solve },
+  { STInputPlainTextTwinsHandler, &input_plaintext_twins_handle },
+  { STSolvingMachineryIntroBuilder, &solving_machinery_intro_builder_solve },
+  { STOutputPlainTextOptionNoboard, &output_plaintext_option_noboard_solve },
+  { STOutputPlaintextTwinIntroWriterBuilder, &output_plaintext_twin_intro_writer_builder_solve },
+  { STOutputLaTeXTwinningWriterBuilder, &output_latex_twinning_writer_builder_solve },
+  { STStartOfCurrentTwin, &slices_deallocator_solve },
+  { STDuplexSolver, &duplex_solve },
+  { STHalfDuplexSolver, &half_duplex_solve },
+  { STCreateBuilderSetupPly, &create_builder_setup_ply_solve },
+  { STPieceWalkCacheInitialiser, &piece_walk_caches_initialiser_solve },
+  { STPiecesCounter, &pieces_counter_solve },
+  { STPiecesFlagsInitialiser, &initialise_piece_flags_solve },
+  { STRoyalsLocator, &royals_locator_solve },
+  { STProofgameVerifyUniqueGoal, &proof_verify_unique_goal_solve },
+  { STProofgameStartPositionInitialiser, &proof_initialise_start_position },
+  { STProofSolver, &proof_solve },
+  { STInputVerification, &verify_position },
+  { STMoveEffectsJournalReset, &move_effect_journal_reset },
+  { STSolversBuilder1, &build_solvers1 },
+  { STSolversBuilder2, &build_solvers2 },
+  { STProxyResolver, &proxies_resolve },
+  { STFilterFuser, &filters_fuse },
+  { STSlackLengthAdjuster, &adjust_slack_length },
+  { STThreatSolver, &threat_solver_solve },
+  { STDummyMove, &dummy_move_solve },
+  { STThreatCollector, &threat_collector_solve },
+  { STThreatEnforcer, &threat_enforcer_solve },
+  { STThreatDefeatedTester, &threat_defeated_tester_solve },
+  { STOutputPlainTextThreatWriter, &output_plaintext_tree_threat_writer_solve },
+  { STOutputPlainTextZugzwangByDummyMoveCheckWriter, &output_plaintext_tree_zugzwang_by_dummy_move_check_writer_solve },
+  { STOutputPlainTextZugzwangWriter, &output_plaintext_tree_zugzwang_writer_solve },
+  { STOutputPlainTextKeyWriter, &output_plaintext_tree_key_writer_solve },
+  { STOutputPlainTextTryWriter, &output_plaintext_tree_try_writer_solve },
+  { STRefutationsAllocator, &refutations_allocator_solve },
+  { STRefutationsSolver, &refutations_solver_solve },
+  { STOutputPlainTextRefutationsIntroWriter, &output_plaintext_tree_refutations_intro_writer_solve },
+  { STRefutationsAvoider, &refutations_avoider_solve },
+  { STRefutationsFilter, &refutations_filter_solve },
+  { STOutputPlaintextTreeRefutingVariationWriter, &output_plaintext_tree_refuting_variation_writer_solve },
+  { STOutputPlaintextLineRefutingVariationWriter, &output_plaintext_line_refuting_variation_writer_solve },
+  { STOutputPlainTextMoveWriter, &output_plaintext_tree_move_writer_solve },
+  { STTrivialEndFilter, &trivial_end_filter_solve },
+  { STNoShortVariations, &no_short_variations_solve },
+  { STOr, &or_solve },
+  { STFindShortest, &find_shortest_solve },
+  { STMoveGenerator, &move_generator_solve },
+  { STForEachAttack, &for_each_attack_solve },
+  { STFindAttack, &find_attack_solve },
+  { STForEachDefense, &for_each_defense_solve },
+  { STFindDefense, &find_defense_solve },
+  { STNullMovePlayer, &null_move_player_solve },
+  { STPostMoveIterationInitialiser, &move_execution_post_move_iterator_solve },
+  { STMoveEffectJournalUndoer, &move_effect_journal_undoer_solve },
+  { STMessignyMovePlayer, &messigny_move_player_solve },
+  { STCastlingPlayer, &castling_player_solve },
+  { STMovePlayer, &move_player_solve },
+  { STEnPassantAdjuster, &en_passant_adjuster_solve },
+  { STEinsteinEnPassantAdjuster, &einstein_en_passant_adjuster_solve },
+  { STPawnPromoter, &pawn_promoter_solve },
+  { STMarsCirceMoveToRebirthSquare, &marscirce_move_to_rebirth_square_solve },
+  { STKamikazeCapturingPieceRemover, &kamikaze_capturing_piece_remover_solve },
+  { STHaanChessHoleInserter, &haan_chess_hole_inserter_solve },
+  { STCastlingChessMovePlayer, &castling_chess_move_player_solve },
+  { STExchangeCastlingMovePlayer, &exchange_castling_move_player_solve },
+  { STSuperTransmutingKingTransmuter, &supertransmuting_kings_transmuter_solve },
+  { STSuperTransmutingKingMoveGenerationFilter, &supertransmuting_kings_move_generation_filter_solve },
+  { STAMUAttackCounter, &amu_attack_counter_solve },
+  { STMutualCastlingRightsAdjuster, &mutual_castling_rights_adjuster_solve },
+  { STImitatorMover, &imitator_mover_solve },
+  { STImitatorRemoveIllegalMoves, &imitator_remove_illegal_moves_solve },
+  { STImitatorDetectIllegalMoves, &imitator_detect_illegal_moves_solve },
+  { STPawnToImitatorPromoter, &imitator_pawn_promoter_solve },
+  { STAttackPlayed, &attack_played_solve },
 
 #if defined(DOTRACE)
-    case STMoveTracer:
-      move_tracer_solve(si);
-      break;
+  { STMoveTracer, &move_tracer_solve },
 #endif
 
-#if defined(DOMEASURE)
-    case STMoveCounter:
-      move_counter_solve(si);
-      break;
+  { STProfileWriter, &profile_writer_solve },
+  { STPerftWriter, &perft_writer_solve },
 
-    case STCountersWriter:
-      counters_writer_solve(si);
-      break;
+#if defined(DOMEASURE)
+  { STMoveCounter, &move_counter_solve },
+  { STCountersWriter, &counters_writer_solve },
 #endif
 
-    case STOrthodoxMatingMoveGenerator:
-      orthodox_mating_move_generator_solve(si);
-      break;
-
-    case STOrthodoxMatingKingContactGenerator:
-      orthodox_mating_king_contact_generator_solve(si);
-      break;
-
-    case STDeadEnd:
-    case STDeadEndGoal:
-      dead_end_solve(si);
-      break;
-
-    case STMinLengthOptimiser:
-      min_length_optimiser_solve(si);
-      break;
-
-    case STForkOnRemaining:
-      fork_on_remaining_solve(si);
-      break;
-
-    case STHashOpener:
-      hash_opener_solve(si);
-      break;
-
-    case STAttackHashed:
-      attack_hashed_solve(si);
-      break;
-
-    case STAttackHashedTester:
-      attack_hashed_tester_solve(si);
-      break;
-
-    case STHelpHashed:
-      help_hashed_solve(si);
-      break;
-
-    case STHelpHashedTester:
-      help_hashed_tester_solve(si);
-      break;
-
-    case STEndOfBranch:
-    case STEndOfBranchForced:
-    case STEndOfBranchTester:
-      end_of_branch_solve(si);
-      break;
-
-    case STEndOfBranchGoal:
-    case STEndOfBranchGoalImmobile:
-    case STEndOfBranchGoalTester:
-      end_of_branch_goal_solve(si);
-      break;
-
-    case STGoalReachedTester:
-      goal_reached_tester_solve(si);
-      break;
-
-    case STAvoidUnsolvable:
-      avoid_unsolvable_solve(si);
-      break;
-
-    case STResetUnsolvable:
-      reset_unsolvable_solve(si);
-      break;
-
-    case STLearnUnsolvable:
-      learn_unsolvable_solve(si);
-      break;
-
-    case STConstraintSolver:
-    case STConstraintTester:
-    case STGoalConstraintTester:
-      constraint_solve(si);
-      break;
-
-    case STSelfCheckGuard:
-    case STExclusiveChessGoalReachingMoveCounterSelfCheckGuard:
-      selfcheck_guard_solve(si);
-      break;
-
-    case STKeepMatingFilter:
-      keepmating_filter_solve(si);
-      break;
-
-    case STOutputPlaintextTreeCheckWriter:
-      output_plaintext_tree_check_writer_solve(si);
-      break;
-
-    case STOutputPlainTextRefutationWriter:
-      output_plaintext_tree_refutation_writer_solve(si);
-      break;
-
-    case STDoubleMateFilter:
-      doublemate_filter_solve(si);
-      break;
-
-    case STCounterMateFilter:
-      countermate_filter_solve(si);
-      break;
-
-    case STEnPassantFilter:
-      enpassant_filter_solve(si);
-      break;
-
-    case STEnPassantRemoveNonReachers:
-      enpassant_remove_non_reachers_solve(si);
-      break;
-
-    case STCastlingFilter:
-      castling_filter_solve(si);
-      break;
-
-    case STCastlingRemoveNonReachers:
-      castling_remove_non_reachers_solve(si);
-      break;
-
-    case STPrerequisiteOptimiser:
-      goal_prerequisite_optimiser_solve(si);
-      break;
-
-    case STChess81RemoveNonReachers:
-      chess81_remove_non_reachers_solve(si);
-      break;
-
-    case STCaptureRemoveNonReachers:
-      capture_remove_non_reachers_solve(si);
-      break;
-
-    case STTargetRemoveNonReachers:
-      target_remove_non_reachers_solve(si);
-      break;
-
-    case STDetectMoveRetracted:
-      detect_move_retracted_solve(si);
-      break;
-
-    case STRetractionPrioriser:
-      priorise_retraction_solve(si);
-      break;
-
-    case STOutputPlaintextProblemWriter:
-      output_plaintext_problem_writer_solve(si);
-      break;
-
-    case STOutputPlaintextGoalWriter:
-      output_plaintext_goal_writer_solve(si);
-      break;
-
-    case STOutputPlaintextLineLineWriter:
-      output_plaintext_line_line_writer_solve(si);
-      break;
-
-    case STOutputLaTeXGoalWriter:
-      output_latex_goal_writer_solve(si);
-      break;
-
-    case STOutputLaTeXLineLineWriter:
-      output_latex_line_line_writer_solve(si);
-      break;
-
-    case STOutputLaTeXProblemWriter:
-      output_latex_problem_writer_solve(si);
-      break;
-
-    case STOutputLaTeXProblemIntroWriter:
-      output_latex_problem_intro_writer_solve(si);
-      break;
-
-    case STOutputLaTeXTwinningWriter:
-      output_latex_write_twinning(si);
-      break;
-
-    case STOutputLaTeXKeyWriter:
-      output_latex_tree_key_writer_solve(si);
-      break;
-
-    case STOutputLaTeXMoveWriter:
-      output_latex_tree_move_writer_solve(si);
-      break;
-
-    case STOutputLaTeXRefutationWriter:
-      output_latex_tree_refutation_writer_solve(si);
-      break;
-
-    case STOutputLaTeXThreatWriter:
-      output_latex_tree_threat_writer_solve(si);
-      break;
-
-    case STOutputLaTeXTreeCheckWriter:
-      output_latex_tree_check_writer_solve(si);
-      break;
-
-    case STOutputLaTeXTreeRefutingVariationWriter:
-      output_latex_tree_refuting_variation_writer_solve(si);
-      break;
-
-    case STOutputLaTeXTryWriter:
-      output_latex_tree_try_writer_solve(si);
-      break;
-
-    case STOutputLaTeXZugzwangByDummyMoveCheckWriter:
-      output_latex_tree_zugzwang_by_dummy_move_check_writer_solve(si);
-      break;
-
-    case STOutputLaTeXZugzwangWriter:
-      output_latex_tree_zugzwang_writer_solve(si);
-      break;
-
-    case STBGLEnforcer:
-      bgl_enforcer_solve(si);
-      break;
-
-    case STBGLAdjuster:
-      bgl_adjuster_solve(si);
-      break;
-
-    case STMasandRecolorer:
-      masand_recolorer_solve(si);
-      break;
-
-    case STActuatedRevolvingCentre:
-      actuated_revolving_centre_solve(si);
-      break;
-
-    case STActuatedRevolvingBoard:
-      actuated_revolving_board_solve(si);
-      break;
-
-    case STRepublicanKingPlacer:
-      republican_king_placer_solve(si);
-      break;
-
-    case STRepublicanType1DeadEnd:
-      republican_type1_dead_end_solve(si);
-      break;
-
-    case STCirceCaptureFork:
-      circe_capture_fork_solve(si);
-      break;
-
-    case STCircePreventKingRebirth:
-      circe_prevent_king_rebirth_solve(si);
-      break;
-
-    case STCirceInitialiseRelevantFromReborn:
-      circe_initialise_relevant_from_reborn(si);
-      break;
-
-    case STCirceInitialiseFromCurrentMove:
-      circe_make_current_move_relevant_solve(si);
-      break;
-
-    case STCirceInitialiseFromLastMove:
-      circe_make_last_move_relevant_solve(si);
-      break;
-
-    case STCirceInitialiseRebornFromCapturee:
-      circe_initialise_reborn_from_capturee_solve(si);
-      break;
-
-    case STCirceCloneDetermineRebornWalk:
-      circe_clone_determine_reborn_walk_solve(si);
-      break;
-
-    case STAntiCloneCirceDetermineRebornWalk:
-      anti_clone_circe_determine_reborn_walk_solve(si);
-      break;
-
-    case STCirceDoubleAgentsAdaptRebornSide:
-      circe_doubleagents_adapt_reborn_side_solve(si);
-      break;
-
-    case STChameleonCirceAdaptRebornWalk:
-      chameleon_circe_adapt_reborn_walk_solve(si);
-      break;
-
-    case STCirceEinsteinAdjustRebornWalk:
-      circe_einstein_adjust_reborn_walk_solve(si);
-      break;
-
-    case STCirceReverseEinsteinAdjustRebornWalk:
-      circe_reverse_einstein_adjust_reborn_walk_solve(si);
-      break;
-
-    case STCirceCouscousMakeCapturerRelevant:
-      circe_couscous_make_capturer_relevant_solve(si);
-      break;
-
-    case STAnticirceCouscousMakeCaptureeRelevant:
-      anticirce_couscous_make_capturee_relevant_solve(si);
-      break;
-
-    case STMirrorCirceOverrideRelevantSide:
-      mirror_circe_override_relevant_side_solve(si);
-      break;
-
-    case STCirceDetermineRebirthSquare:
-      circe_determine_rebirth_square_solve(si);
-      break;
-
-    case STCirceFrischaufAdjustRebirthSquare:
-      frischauf_adjust_rebirth_square_solve(si);
-      break;
-
-    case STCirceGlasgowAdjustRebirthSquare:
-      circe_glasgow_adjust_rebirth_square_solve(si);
-      break;
-
-    case STFileCirceDetermineRebirthSquare:
-      file_circe_determine_rebirth_square_solve(si);
-      break;
-
-    case STCirceDiametralAdjustRebirthSquare:
-      circe_diametral_adjust_rebirth_square_solve(si);
-      break;
-
-    case STCirceVerticalMirrorAdjustRebirthSquare:
-      circe_verticalmirror_adjust_rebirth_square_solve(si);
-      break;
-
-    case STRankCirceOverrideRelevantSide:
-      rank_circe_override_relevant_side_solve(si);
-      break;
-
-    case STRankCirceProjectRebirthSquare:
-      rank_circe_adjust_rebirth_square_solve(si);
-      break;
-
-    case STTakeMakeCirceDetermineRebirthSquares:
-      take_make_circe_determine_rebirth_squares_solve(si);
-      break;
-
-    case STTakeMakeCirceCollectRebirthSquares:
-      take_make_circe_collect_rebirth_squares_solve(si);
-      break;
-
-    case STAntipodesCirceDetermineRebirthSquare:
-      antipodes_circe_determine_rebirth_square_solve(si);
-      break;
-
-    case STSymmetryCirceDetermineRebirthSquare:
-      symmetry_circe_determine_rebirth_square_solve(si);
-      break;
-
-    case STPWCDetermineRebirthSquare:
-      pwc_determine_rebirth_square_solve(si);
-      break;
-
-    case STDiagramCirceDetermineRebirthSquare:
-      diagram_circe_determine_rebirth_square_solve(si);
-      break;
-
-    case STContactGridAvoidCirceRebirth:
-      contact_grid_avoid_circe_rebirth(si);
-      break;
-
-    case STGenevaStopCaptureFromRebirthSquare:
-      geneva_stop_catpure_from_rebirth_square_solve(si);
-      break;
-
-    case STCirceTestRebirthSquareEmpty:
-      circe_test_rebirth_square_empty_solve(si);
-      break;
-
-    case STCircePlaceReborn:
-      circe_place_reborn_solve(si);
-      break;
-
-    case STCirceDoneWithRebirth:
-      circe_done_with_rebirth(si);
-      break;
-
-    case STAprilCaptureFork:
-      april_chess_fork_solve(si);
-      break;
-
-    case STSuperCirceNoRebirthFork:
-      supercirce_no_rebirth_fork_solve(si);
-      break;
-
-    case STSuperCirceDetermineRebirthSquare:
-      supercirce_determine_rebirth_square_solve(si);
-      break;
-
-    case STSupercircePreventRebirthOnNonEmptySquare:
-      supercirce_prevent_rebirth_on_non_empty_square_solve(si);
-      break;
-
-    case STCirceVolageRecolorer:
-      circe_volage_recolorer_solve(si);
-      break;
-
-    case STCirceParrainThreatFork:
-      circe_parrain_threat_fork_solve(si);
-      break;
-
-    case STCirceParrainDetermineRebirth:
-      circe_parrain_determine_rebirth_solve(si);
-      break;
-
-    case STCirceContraparrainDetermineRebirth:
-      circe_contraparrain_determine_rebirth_solve(si);
-      break;
-
-    case STCirceCageNoCageFork:
-      circe_cage_no_cage_fork_solve(si);
-      break;
-
-    case STCirceCageCageTester:
-      circe_cage_cage_tester_solve(si);
-      break;
-
-    case STCageCirceFutileCapturesRemover:
-      circe_cage_futile_captures_remover_solve(si);
-      break;
-
-    case STSentinellesInserter:
-      sentinelles_inserter_solve(si);
-      break;
-
-    case STMagicViewsInitialiser:
-      magic_views_initialiser_solve(si);
-      break;
-
-    case STMagicPiecesRecolorer:
-      magic_pieces_recolorer_solve(si);
-      break;
+  { STOrthodoxMatingMoveGenerator, &orthodox_mating_move_generator_solve },
+  { STOrthodoxMatingKingContactGenerator, &orthodox_mating_king_contact_generator_solve },
+  { STOrthodoxPinsDetector, &orthodox_pins_detector_solve },
+  { STOrthodoxSelfCheckGuard, &orthodox_selfcheck_guard_solve },
+  { STDeadEnd, &dead_end_solve },
+  { STDeadEndGoal, &dead_end_solve },
+  { STMinLengthOptimiser, &min_length_optimiser_solve },
+  { STForkOnRemaining, &fork_on_remaining_solve },
+  { STHashOpener, &hash_opener_solve },
+  { STAttackHashed, &attack_hashed_solve },
+  { STAttackHashedTester, &attack_hashed_tester_solve },
+  { STHelpHashed, &help_hashed_solve },
+  { STHelpHashedTester, &help_hashed_tester_solve },
+  { STEndOfBranch, &end_of_branch_solve },
+  { STEndOfBranchForced, &end_of_branch_solve },
+  { STEndOfBranchTester, &end_of_branch_solve },
+  { STEndOfBranchGoal, &end_of_branch_goal_solve },
+  { STEndOfBranchGoalImmobile, &end_of_branch_goal_solve },
+  { STEndOfBranchGoalTester, &end_of_branch_goal_solve },
+  { STGoalReachedTester, &goal_reached_tester_solve },
+  { STAvoidUnsolvable, &avoid_unsolvable_solve },
+  { STResetUnsolvable, &reset_unsolvable_solve },
+  { STLearnUnsolvable, &learn_unsolvable_solve },
+  { STConstraintSolver, &constraint_solve },
+  { STConstraintTester, &constraint_solve },
+  { STGoalConstraintTester, &constraint_solve },
+  { STSelfCheckGuard, &selfcheck_guard_solve },
+  { STExclusiveChessGoalReachingMoveCounterSelfCheckGuard, &selfcheck_guard_solve },
+  { STKeepMatingFilter, &keepmating_filter_solve },
+  { STOutputPlaintextTreeCheckWriter, &output_plaintext_tree_check_writer_solve },
+  { STOutputPlainTextRefutationWriter, &output_plaintext_tree_refutation_writer_solve },
+  { STDoubleMateFilter, &doublemate_filter_solve },
+  { STCounterMateFilter, &countermate_filter_solve },
+  { STEnPassantFilter, &enpassant_filter_solve },
+  { STEnPassantRemoveNonReachers, &enpassant_remove_non_reachers_solve },
+  { STCastlingFilter, &castling_filter_solve },
+  { STCastlingRemoveNonReachers, &castling_remove_non_reachers_solve },
+  { STPrerequisiteOptimiser, &goal_prerequisite_optimiser_solve },
+  { STChess81RemoveNonReachers, &chess81_remove_non_reachers_solve },
+  { STCaptureRemoveNonReachers, &capture_remove_non_reachers_solve },
+  { STTargetRemoveNonReachers, &target_remove_non_reachers_solve },
+  { STDetectMoveRetracted, &detect_move_retracted_solve },
+  { STRetractionPrioriser, &priorise_retraction_solve },
+  { STOutputPlaintextProblemWriter, &output_plaintext_problem_writer_solve },
+  { STOutputPlaintextGoalWriter, &output_plaintext_goal_writer_solve },
+  { STOutputPlaintextLineLineWriter, &output_plaintext_line_line_writer_solve },
+  { STOutputLaTeXGoalWriter, &output_latex_goal_writer_solve },
+  { STOutputLaTeXLineLineWriter, &output_latex_line_line_writer_solve },
+  { STOutputLaTeXProblemWriter, &output_latex_problem_writer_solve },
+  { STOutputLaTeXProblemIntroWriter, &output_latex_problem_intro_writer_solve },
+  { STOutputLaTeXTwinningWriter, &output_latex_write_twinning },
+  { STOutputLaTeXKeyWriter, &output_latex_tree_key_writer_solve },
+  { STOutputLaTeXMoveWriter, &output_latex_tree_move_writer_solve },
+  { STOutputLaTeXRefutationWriter, &output_latex_tree_refutation_writer_solve },
+  { STOutputLaTeXThreatWriter, &output_latex_tree_threat_writer_solve },
+  { STOutputLaTeXTreeCheckWriter, &output_latex_tree_check_writer_solve },
+  { STOutputLaTeXTreeRefutingVariationWriter, &output_latex_tree_refuting_variation_writer_solve },
+  { STOutputLaTeXTryWriter, &output_latex_tree_try_writer_solve },
+  { STOutputLaTeXZugzwangByDummyMoveCheckWriter, &output_latex_tree_zugzwang_by_dummy_move_check_writer_solve },
+  { STOutputLaTeXZugzwangWriter, &output_latex_tree_zugzwang_writer_solve },
+  { STBGLEnforcer, &bgl_enforcer_solve },
+  { STBGLAdjuster, &bgl_adjuster_solve },
+  { STMasandRecolorer, &masand_recolorer_solve },
+  { STActuatedRevolvingCentre, &actuated_revolving_centre_solve },
+  { STActuatedRevolvingBoard, &actuated_revolving_board_solve },
+  { STRepublicanKingPlacer, &republican_king_placer_solve },
+  { STRepublicanType1DeadEnd, &republican_type1_dead_end_solve },
+  { STCirceCaptureFork, &circe_capture_fork_solve },
+  { STCircePreventKingRebirth, &circe_prevent_king_rebirth_solve },
+  { STCirceInitialiseRelevantFromReborn, &circe_initialise_relevant_from_reborn },
+  { STCirceInitialiseFromCurrentMove, &circe_make_current_move_relevant_solve },
+  { STCirceInitialiseFromLastMove, &circe_make_last_move_relevant_solve },
+  { STCirceInitialiseRebornFromCapturee, &circe_initialise_reborn_from_capturee_solve },
+  { STCirceCloneDetermineRebornWalk, &circe_clone_determine_reborn_walk_solve },
+  { STAntiCloneCirceDetermineRebornWalk, &anti_clone_circe_determine_reborn_walk_solve },
+  { STCirceDoubleAgentsAdaptRebornSide, &circe_doubleagents_adapt_reborn_side_solve },
+  { STChameleonCirceAdaptRebornWalk, &chameleon_circe_adapt_reborn_walk_solve },
+  { STCirceEinsteinAdjustRebornWalk, &circe_einstein_adjust_reborn_walk_solve },
+  { STCirceReverseEinsteinAdjustRebornWalk, &circe_reverse_einstein_adjust_reborn_walk_solve },
+  { STCirceCouscousMakeCapturerRelevant, &circe_couscous_make_capturer_relevant_solve },
+  { STAnticirceCouscousMakeCaptureeRelevant, &anticirce_couscous_make_capturee_relevant_solve },
+  { STMirrorCirceOverrideRelevantSide, &mirror_circe_override_relevant_side_solve },
+  { STCirceDetermineRebirthSquare, &circe_determine_rebirth_square_solve },
+  { STCirceFrischaufAdjustRebirthSquare, &frischauf_adjust_rebirth_square_solve },
+  { STCirceGlasgowAdjustRebirthSquare, &circe_glasgow_adjust_rebirth_square_solve },
+  { STFileCirceDetermineRebirthSquare, &file_circe_determine_rebirth_square_solve },
+  { STCirceDiametralAdjustRebirthSquare, &circe_diametral_adjust_rebirth_square_solve },
+  { STCirceVerticalMirrorAdjustRebirthSquare, &circe_verticalmirror_adjust_rebirth_square_solve },
+  { STRankCirceOverrideRelevantSide, &rank_circe_override_relevant_side_solve },
+  { STRankCirceProjectRebirthSquare, &rank_circe_adjust_rebirth_square_solve },
+  { STTakeMakeCirceDetermineRebirthSquares, &take_make_circe_determine_rebirth_squares_solve },
+  { STTakeMakeCirceCollectRebirthSquares, &take_make_circe_collect_rebirth_squares_solve },
+  { STAntipodesCirceDetermineRebirthSquare, &antipodes_circe_determine_rebirth_square_solve },
+  { STSymmetryCirceDetermineRebirthSquare, &symmetry_circe_determine_rebirth_square_solve },
+  { STPWCDetermineRebirthSquare, &pwc_determine_rebirth_square_solve },
+  { STDiagramCirceDetermineRebirthSquare, &diagram_circe_determine_rebirth_square_solve },
+  { STContactGridAvoidCirceRebirth, &contact_grid_avoid_circe_rebirth },
+  { STGenevaStopCaptureFromRebirthSquare, &geneva_stop_catpure_from_rebirth_square_solve },
+  { STCirceTestRebirthSquareEmpty, &circe_test_rebirth_square_empty_solve },
+  { STCircePlaceReborn, &circe_place_reborn_solve },
+  { STCirceDoneWithRebirth, &circe_done_with_rebirth },
+  { STAprilCaptureFork, &april_chess_fork_solve },
+  { STSuperCirceNoRebirthFork, &supercirce_no_rebirth_fork_solve },
+  { STSuperCirceDetermineRebirthSquare, &supercirce_determine_rebirth_square_solve },
+  { STSupercircePreventRebirthOnNonEmptySquare, &supercirce_prevent_rebirth_on_non_empty_square_solve },
+  { STCirceVolageRecolorer, &circe_volage_recolorer_solve },
+  { STCirceParrainThreatFork, &circe_parrain_threat_fork_solve },
+  { STCirceParrainDetermineRebirth, &circe_parrain_determine_rebirth_solve },
+  { STCirceContraparrainDetermineRebirth, &circe_contraparrain_determine_rebirth_solve },
+  { STCirceCageNoCageFork, &circe_cage_no_cage_fork_solve },
+  { STCirceCageCageTester, &circe_cage_cage_tester_solve },
+  { STCageCirceFutileCapturesRemover, &circe_cage_futile_captures_remover_solve },
+  { STSentinellesInserter, &sentinelles_inserter_solve },
+  { STMagicViewsInitialiser, &magic_views_initialiser_solve },
+  { STMagicPiecesRecolorer, &magic_pieces_recolorer_solve },
+  { STHauntedChessGhostSummoner, &haunted_chess_ghost_summoner_solve },
+  { STHauntedChessGhostRememberer, &haunted_chess_ghost_rememberer_solve },
+  { STGhostChessGhostRememberer, &ghost_chess_ghost_rememberer_solve },
+  { STAndernachSideChanger, &andernach_side_changer_solve },
+  { STAntiAndernachSideChanger, &antiandernach_side_changer_solve },
+  { STChameleonPursuitSideChanger, &chameleon_pursuit_side_changer_solve },
+  { STLostPiecesRemover, &lostpieces_remover_solve },
+  { STNorskRemoveIllegalCaptures, &norsk_remove_illegal_captures_solve },
+  { STNorskArrivingAdjuster, &norsk_arriving_adjuster_solve },
+  { STProteanPawnAdjuster, &protean_pawn_adjuster_solve },
+  { STEinsteinArrivingAdjuster, &einstein_moving_adjuster_solve },
+  { STReverseEinsteinArrivingAdjuster, &reverse_einstein_moving_adjuster_solve },
+  { STAntiEinsteinArrivingAdjuster, &anti_einstein_moving_adjuster_solve },
+  { STTraitorSideChanger, &traitor_side_changer_solve },
+  { STVolageSideChanger, &volage_side_changer_solve },
+  { STMagicSquareSideChanger, &magic_square_side_changer_solve },
+  { STMagicSquareType2SideChanger, &magic_square_side_changer_solve },
+  { STMagicSquareType2AnticirceRelevantSideAdapter, &magic_square_anticirce_relevant_side_adapter_solve },
+  { STTibetSideChanger, &tibet_solve },
+  { STDoubleTibetSideChanger, &double_tibet_solve },
+  { STDegradierungDegrader, &degradierung_degrader_solve },
+  { STChameleonChangePromoteeInto, &chameleon_change_promotee_into_solve },
+  { STChameleonArrivingAdjuster, &chameleon_arriving_adjuster_solve },
+  { STChameleonChessArrivingAdjuster, &chameleon_chess_arriving_adjuster_solve },
+  { STLineChameleonArrivingAdjuster, &line_chameleon_arriving_adjuster_solve },
+  { STFrischaufPromoteeMarker, &frischauf_promotee_marker_solve },
+  { STPiecesHalfNeutralRecolorer, &half_neutral_recolorer_solve },
+  { STKobulKingSubstitutor, &kobul_king_substitutor_solve },
+  { STSnekSubstitutor, &snek_substitutor_solve },
+  { STSnekCircleSubstitutor, &snek_circle_substitutor_solve },
+  { STDuellistsRememberDuellist, &duellists_remember_duellist_solve },
+  { STSingleboxType2LatentPawnSelector, &singlebox_type2_latent_pawn_selector_solve },
+  { STSingleboxType2LatentPawnPromoter, &singlebox_type2_latent_pawn_promoter_solve },
+  { STCirceKamikazeCaptureFork, &circe_kamikaze_capture_fork_solve },
+  { STAnticirceInitialiseRebornFromCapturer, &circe_initialise_reborn_from_capturer_solve },
+  { STMarscirceInitialiseRebornFromGenerated, &marscirce_initialise_reborn_from_generated_solve },
+  { STGenevaInitialiseRebornFromCapturer, &geneva_initialise_reborn_from_capturer_solve },
+  { STAnticirceCheylanFilter, &anticirce_cheylan_filter_solve },
+  { STAnticirceRemoveCapturer, &anticirce_remove_capturer_solve },
+  { STMarscirceRemoveCapturer, &marscirce_remove_capturer_solve },
+  { STFootballChessSubsitutor, &football_chess_substitutor_solve },
+  { STRefutationsCollector, &refutations_collector_solve },
+  { STMinLengthGuard, &min_length_guard_solve },
+  { STDegenerateTree, &degenerate_tree_solve },
+  { STMaxNrNonTrivialCounter, &max_nr_nontrivial_counter_solve },
+  { STKillerDefenseCollector, &killer_defense_collector_solve },
+  { STFindByIncreasingLength, &find_by_increasing_length_solve },
+  { STHelpMovePlayed, &help_move_played_solve },
+  { STIntelligentMovesLeftInitialiser, &intelligent_moves_left_initialiser_solve },
+  { STRestartGuardIntelligent, &restart_guard_intelligent_solve },
+  { STIntelligentTargetCounter, &intelligent_target_counter_solve },
+  { STIntelligentFilter, &intelligent_filter_solve },
+  { STIntelligentFlightsGuarder, &intelligent_guard_flights },
+  { STIntelligentFlightsBlocker, &intelligent_find_and_block_flights },
+  { STIntelligentMateTargetPositionTester, &intelligent_mate_test_target_position },
+  { STIntelligentStalemateTargetPositionTester, &intelligent_stalemate_test_target_position },
+  { STIntelligentProof, &intelligent_proof_solve },
+  { STIntelligentLimitNrSolutionsPerTargetPosLimiter, &intelligent_limit_nr_solutions_per_target_position_solve },
+  { STGoalReachableGuardFilterMate, &goalreachable_guard_mate_solve },
+  { STGoalReachableGuardFilterStalemate, &goalreachable_guard_stalemate_solve },
+  { STGoalReachableGuardFilterProof, &goalreachable_guard_proofgame_solve },
+  { STGoalReachableGuardFilterProofFairy, &goalreachable_guard_proofgame_fairy_solve },
+  { STRestartGuard, &restart_guard_solve },
+  { STRestartGuardNested, &restart_guard_nested_solve },
+  { STRootMoveSplitter, &root_move_splitter_solve },
+  { STIntelligentTargetPositionSplitter, &root_move_splitter_solve },
+  { STPerftRootMoveWriter, &perft_root_move_writer_solve },
+  { STPerftSequenceCounter, &perft_sequence_counter_solve },
+  { STMaxTimeProblemInstrumenter, &maxtime_problem_instrumenter_solve },
+  { STMaxTimeSetter, &maxtime_set },
+  { STMaxTimeGuard, &maxtime_guard_solve },
+  { STMaxSolutionsProblemInstrumenter, &maxsolutions_problem_instrumenter_solve },
+  { STMaxSolutionsSolvingInstrumenter, &maxsolutions_solving_instrumenter_solve },
+  { STMaxSolutionsCounter, &maxsolutions_counter_solve },
+  { STMaxSolutionsGuard, &maxsolutions_guard_solve },
+  { STStopOnShortSolutionsSolvingInstrumenter, &stoponshortsolutions_solving_instrumenter_solve },
+  { STStopOnShortSolutionsFilter, &stoponshortsolutions_solve },
+  { STIfThenElse, &if_then_else_solve },
+  { STFlightsquaresCounter, &flightsquares_counter_solve },
+  { STKingMoveGenerator, &king_move_generator_solve },
+  { STNonKingMoveGenerator, &non_king_move_generator_solve },
+  { STUltraMummerMeasurerDeadend, &ultra_mummer_measurer_deadend_solve },
+  { STLegalAttackCounter, &legal_attack_counter_solve },
+  { STAnyMoveCounter, &legal_attack_counter_solve },
+  { STLegalDefenseCounter, &legal_defense_counter_solve },
+  { STCaptureCounter, &capture_counter_solve },
+  { STOhneschachStopIfCheck, &ohneschach_stop_if_check_solve },
+  { STOhneschachStopIfCheckAndNotMate, &ohneschach_stop_if_check_and_not_mate_solve },
+  { STOhneschachDetectUndecidableGoal, &ohneschach_detect_undecidable_goal_solve },
+  { STRecursionStopper, &recursion_stopper_solve },
+  { STSinglePieceMoveGenerator, &single_piece_move_generator_solve },
+  { STCastlingRightsAdjuster, &castling_rights_adjuster_solve },
+  { STOpponentMovesCounter, &opponent_moves_counter_solve },
+  { STOpponentMovesFewMovesPrioriser, &opponent_moves_few_moves_prioriser_solve },
+  { STIntelligentImmobilisationCounter, &intelligent_immobilisation_counter_solve },
+  { STIntelligentDuplicateAvoider, &intelligent_duplicate_avoider_solve },
+  { STIntelligentSolutionRememberer, &intelligent_solution_rememberer_solve },
+  { STIntelligentSolutionsPerTargetPosProblemInstrumenter, &intelligent_nr_solutions_per_target_position_problem_instrumenter_solve },
+  { STIntelligentSolutionsPerTargetPosSolvingInstrumenter, &intelligent_nr_solutions_per_target_position_solving_instrumenter_solve },
+  { STIntelligentSolutionsPerTargetPosInitialiser, &intelligent_nr_solutions_per_target_position_initialiser_solve },
+  { STIntelligentSolutionsPerTargetPosCounter, &intelligent_nr_solutions_per_target_position_counter_solve },
+  { STSetplayFork, &setplay_fork_solve },
+  { STAttackAdapter, &attack_adapter_solve },
+  { STDefenseAdapter, &defense_adapter_solve },
+  { STHelpAdapter, &help_adapter_solve },
+  { STAnd, &and_solve },
+  { STNot, &not_solve },
+  { STMoveInverter, &move_inverter_solve },
+  { STMoveInverterSetPlay, &move_inverter_solve },
+  { STRetroStartRetractionPly, &retro_start_retraction_ply },
+  { STRetroPlayNullMove, &retro_play_null_move },
+  { STRetroRetractLastCapture, &circe_parrain_undo_retro_capture },
+  { STRetroRedoLastCapture, &circe_parrain_redo_retro_capture },
+  { STRetroUndoLastPawnMultistep, &en_passant_undo_multistep },
+  { STRetroRedoLastPawnMultistep, &en_passant_redo_multistep },
+  { STRetroStartRetroMovePly, &retro_start_retro_move_ply },
+  { STMaxSolutionsInitialiser, &maxsolutions_initialiser_solve },
+  { STStopOnShortSolutionsProblemInstrumenter, &stoponshortsolutions_problem_instrumenter_solve },
+  { STStopOnShortSolutionsWasShortSolutionFound, &stoponshortsolutions_was_short_solution_found_solve },
+  { STOutputPlaintextZeropositionIntroWriter, &output_plaintext_write_zeroposition_intro },
+  { STOutputPlaintextTwinIntroWriter, &output_plaintext_write_twin_intro },
+  { STOutputPlainTextMetaWriter, &output_plaintext_write_meta },
+  { STOutputPlainTextBoardWriter, &output_plaintext_write_board },
+  { STOutputPlainTextPieceCountsWriter, &output_plaintext_write_piece_counts },
+  { STOutputPlainTextRoyalPiecePositionsWriter, &output_plaintext_write_royal_piece_positions },
+  { STOutputPlainTextNonRoyalAttributesWriter, &output_plaintext_write_non_royal_attributes },
+  { STOutputPlainTextConditionsWriter, &output_plaintext_write_conditions },
+  { STOutputPlainTextMutuallyExclusiveCastlingsWriter, &output_plaintext_write_mutually_exclusive_castlings },
+  { STOutputPlainTextDuplexWriter, &output_plaintext_write_duplex },
+  { STOutputPlainTextHalfDuplexWriter, &output_plaintext_write_halfduplex },
+  { STOutputPlainTextQuodlibetWriter, &output_plaintext_write_quodlibet },
+  { STOutputPlainTextAToBIntraWriter, &output_plaintext_write_atob_intra },
+  { STOutputPlainTextStipulationWriter, &output_plaintext_write_stipulation },
+  { STOutputPlainTextGridWriter, &output_plaintext_write_grid },
+  { STOutputPlainTextEndOfPositionWriters, &output_plaintext_end_of_position_writers_solve },
+  { STZeroPositionInitialiser, &zeroposition_initialiser_solve },
+  { STZeropositionSolvingStopper, &zeroposition_solving_stopper_solve },
+  { STIllegalSelfcheckWriter, &illegal_selfcheck_writer_solve },
+  { STOutputPlainTextEndOfPhaseWriter, &output_plaintext_end_of_phase_writer_solve },
+  { STOutputPlaintextMoveInversionCounter, &output_plaintext_move_inversion_counter_solve },
+  { STOutputPlaintextMoveInversionCounterSetPlay, &output_plaintext_move_inversion_counter_solve },
+  { STOutputPlaintextLineEndOfIntroSeriesMarker, &output_plaintext_line_end_of_intro_series_marker_solve },
+  { STPiecesParalysingMateFilter, &paralysing_mate_filter_solve },
+  { STPiecesParalysingStalemateSpecial, &paralysing_stalemate_special_solve },
+  { STPiecesParalysingRemoveCaptures, &paralysing_remove_captures_solve },
+  { STPiecesParalysingSuffocationFinder, &paralysing_suffocation_finder_solve },
+  { STAmuMateFilter, &amu_mate_filter_solve },
+  { STCirceSteingewinnFilter, &circe_steingewinn_filter_solve },
+  { STCirceCircuitSpecial, &circe_circuit_special_solve },
+  { STCirceExchangeSpecial, &circe_exchange_special_solve },
+  { STTemporaryHackFork, &pipe_solve_delegate },
+  { STGoalTargetReachedTester, &goal_target_reached_tester_solve },
+  { STGoalCheckReachedTester, &goal_check_reached_tester_solve },
+  { STGoalCaptureReachedTester, &goal_capture_reached_tester_solve },
+  { STGoalSteingewinnReachedTester, &goal_steingewinn_reached_tester_solve },
+  { STGoalEnpassantReachedTester, &goal_enpassant_reached_tester_solve },
+  { STGoalDoubleMateReachedTester, &goal_doublemate_reached_tester_solve },
+  { STGoalCounterMateReachedTester, &goal_countermate_reached_tester_solve },
+  { STGoalCastlingReachedTester, &goal_castling_reached_tester_solve },
+  { STGoalCircuitReachedTester, &goal_circuit_reached_tester_solve },
+  { STGoalExchangeReachedTester, &goal_exchange_reached_tester_solve },
+  { STGoalCircuitByRebirthReachedTester, &goal_circuit_by_rebirth_reached_tester_solve },
+  { STGoalExchangeByRebirthReachedTester, &goal_exchange_by_rebirth_reached_tester_solve },
+  { STGoalProofgameReachedTester, &goal_proofgame_reached_tester_solve },
+  { STGoalAToBReachedTester, &goal_proofgame_reached_tester_solve },
+  { STGoalImmobileReachedTester, &goal_immobile_reached_tester_solve },
+  { STMaffImmobilityTesterKing, &maff_immobility_tester_king_solve },
+  { STOWUImmobilityTesterKing, &owu_immobility_tester_king_solve },
+  { STGoalNotCheckReachedTester, &goal_notcheck_reached_tester_solve },
+  { STGoalAnyReachedTester, &goal_any_reached_tester_solve },
+  { STGoalChess81ReachedTester, &goal_chess81_reached_tester_solve },
+  { STGoalKissReachedTester, &goal_kiss_reached_tester_solve },
+  { STGoalKingCaptureReachedTester, &goal_king_capture_reached_tester_solve },
+  { STPiecesParalysingMateFilterTester, &paralysing_mate_filter_tester_solve },
+  { STBlackChecks, &blackchecks_solve },
+  { STSingleBoxType1LegalityTester, &singlebox_type1_legality_tester_solve },
+  { STSingleBoxType2LegalityTester, &singlebox_type2_legality_tester_solve },
+  { STSingleBoxType3LegalityTester, &singlebox_type3_legality_tester_solve },
+  { STSingleBoxType3PawnPromoter, &singlebox_type3_pawn_promoter_solve },
+  { STExclusiveChessExclusivityDetector, &exclusive_chess_exclusivity_detector_solve },
+  { STExclusiveChessNestedExclusivityDetector, &exclusive_chess_nested_exclusivity_detector_solve },
+  { STExclusiveChessLegalityTester, &exclusive_chess_legality_tester_solve },
+  { STExclusiveChessGoalReachingMoveCounter, &exclusive_chess_goal_reaching_move_counter_solve },
+  { STExclusiveChessUndecidableWriterTree, &exclusive_chess_undecidable_writer_tree_solve },
+  { STExclusiveChessUndecidableWriterLine, &exclusive_chess_undecidable_writer_line_solve },
+  { STUltraschachzwangLegalityTester, &ultraschachzwang_legality_tester_solve },
+  { STIsardamLegalityTester, &isardam_legality_tester_solve },
+  { STCirceAssassinAssassinate, &circe_assassin_assassinate_solve },
+  { STCirceParachuteRemember, &circe_parachute_remember_solve },
+  { STCirceParachuteUncoverer, &circe_parachute_uncoverer_solve },
+  { STCirceVolcanicRemember, &circe_volcanic_remember_solve },
+  { STCirceVolcanicSwapper, &circe_volcanic_swapper_solve },
+  { STKingSquareUpdater, &king_square_updater_solve },
+  { STOwnKingCaptureAvoider, &own_king_capture_avoider_solve },
+  { STOpponentKingCaptureAvoider, &opponent_king_capture_avoider_solve },
+  { STPatienceChessLegalityTester, &patience_chess_legality_tester_solve },
+  { STStrictSATInitialiser, &strict_sat_initialiser_solve },
+  { STStrictSATUpdater, &strict_sat_updater_solve },
+  { STDynastyKingSquareUpdater, &dynasty_king_square_updater_solve },
+  { STHurdleColourChanger, &hurdle_colour_changer_solve },
+  { STHurdleColourChangeInitialiser, &hurdle_colour_change_initialiser_solve },
+  { STHurdleColourChangerChangePromoteeInto, &hurdle_colour_change_change_promotee_into_solve },
+  { STOscillatingKingsTypeA, &oscillating_kings_type_a_solve },
+  { STOscillatingKingsTypeB, &oscillating_kings_type_b_solve },
+  { STOscillatingKingsTypeC, &oscillating_kings_type_c_solve },
+  { STPlaySuppressor, &play_suppressor_solve },
+  { STContinuationSolver, &continuation_solver_solve },
+  { STDefensePlayed, &defense_played_solve },
+  { STMaxFlightsquares, &maxflight_guard_solve },
+  { STMaxNrNonTrivial, &max_nr_nontrivial_guard_solve },
+  { STOutputPlainTextTreeEndOfSolutionWriter, &output_plaintext_end_of_solution_writer_solve },
+  { STKillerMoveFinalDefenseMove, &killer_move_final_defense_move_solve },
+  { STKillerMovePrioriser, &killer_move_prioriser_solve },
+  { STHistoryMovePrioriser, &history_move_prioriser_solve },
+  { STMaxThreatLength, &maxthreatlength_guard_solve },
+  { STKillerAttackCollector, &killer_attack_collector_solve },
+  { STProofNumberTableOpener, &proof_number_table_opener_solve },
+  { STProofNumberAttackNode, &proof_number_attack_node_solve },
+  { STProofNumberDefenseNode, &proof_number_defense_node_solve },
+  { STFusedFilters, &fused_filters_solve },
+  { STMummerOrchestrator, &mummer_orchestrator_solve },
+  { STMummerBookkeeper, &mummer_bookkeeper_solve },
+  { STBackHomeMovesOnly, &back_home_moves_only_solve },
+  { STNoPromotionsRemovePromotionMoving, &nopromotion_avoid_promotion_moving_solve },
+  { STBackhomeExistanceTester, &backhome_existance_tester_solve },
+  { STBackhomeRemoveIllegalMoves, &backhome_remove_illegal_moves_solve },
+  { STNocaptureRemoveCaptures, &nocapture_remove_captures_solve },
+  { STWoozlesRemoveIllegalCaptures, &woozles_remove_illegal_captures_solve },
+  { STBiWoozlesRemoveIllegalCaptures, &biwoozles_remove_illegal_captures_solve },
+  { STHeffalumpsRemoveIllegalCaptures, &heffalumps_remove_illegal_captures_solve },
+  { STBiHeffalumpsRemoveIllegalCaptures, &biheffalumps_remove_illegal_captures_solve },
+  { STProvocateursRemoveUnobservedCaptures, &provocateurs_remove_unobserved_captures_solve },
+  { STLortapRemoveSupportedCaptures, &lortap_remove_supported_captures_solve },
+  { STPatrolRemoveUnsupportedCaptures, &patrol_remove_unsupported_captures_solve },
+  { STKoekoLegalityTester, &koeko_legality_tester_solve },
+  { STGridContactLegalityTester, &contact_grid_legality_tester_solve },
+  { STAntiKoekoLegalityTester, &antikoeko_legality_tester_solve },
+  { STNewKoekoRememberContact, &newkoeko_remember_contact_solve },
+  { STNewKoekoLegalityTester, &newkoeko_legality_tester_solve },
+  { STJiggerLegalityTester, &jigger_legality_tester_solve },
+  { STMonochromeRemoveBichromeMoves, &monochrome_remove_bichrome_moves_solve },
+  { STBichromeRemoveMonochromeMoves, &bichrome_remove_monochrome_moves_solve },
+  { STEdgeMoverRemoveIllegalMoves, &edgemover_remove_illegal_moves_solve },
+  { STShieldedKingsRemoveIllegalCaptures, &shielded_kings_remove_illegal_captures_solve },
+  { STSuperguardsRemoveIllegalCaptures, &superguards_remove_illegal_captures_solve },
+  { STGridRemoveIllegalMoves, &grid_remove_illegal_moves_solve },
+  { STUncapturableRemoveCaptures, &uncapturable_remove_captures_solve },
+  { STTakeAndMakeGenerateMake, &take_and_make_generate_make_solve },
+  { STTakeAndMakeAvoidPawnMakeToBaseLine, &take_and_make_avoid_pawn_make_to_base_line_solve },
+  { STWormholeRemoveIllegalCaptures, &wormhole_remove_illegal_captures_solve },
+  { STWormholeTransferer, &wormhole_transferer_solve },
+  { STExtinctionExtinctedTester, &extinction_extincted_tester_solve },
+  { STCastlingGeneratorTestDeparture, &castling_generate_test_departure },
+  { STBlackChecksNullMoveGenerator, &black_checks_null_move_generator_solve },
+  { STTrue, &true_solve },
+  { STFalse, &false_solve },
+
+  /* move generators: */
+  { STSingleBoxType3TMovesForPieceGenerator, &singleboxtype3_generate_moves_for_piece },
+  { STMadrasiMovesForPieceGenerator, &madrasi_generate_moves_for_piece },
+  { STPartialParalysisMovesForPieceGenerator, &partial_paralysis_generate_moves_for_piece },
+  { STEiffelMovesForPieceGenerator, &eiffel_generate_moves_for_piece },
+  { STDisparateMovesForPieceGenerator, &disparate_generate_moves_for_piece },
+  { STParalysingMovesForPieceGenerator, &paralysing_generate_moves_for_piece },
+  { STUltraPatrolMovesForPieceGenerator, &ultrapatrol_generate_moves_for_piece },
+  { STCentralMovesForPieceGenerator, &central_generate_moves_for_piece },
+  { STBeamtenMovesForPieceGenerator, &beamten_generate_moves_for_piece },
+  { STMarsCirceMoveGeneratorEnforceRexInclusive, &marscirce_generate_moves_enforce_rex_exclusive },
+  { STPhantomAvoidDuplicateMoves, &phantom_avoid_duplicate_moves },
+  { STPlusAdditionalCapturesForPieceGenerator, &plus_generate_additional_captures_for_piece },
+  { STMoveForPieceGeneratorTwoPaths, &generate_moves_for_piece_two_paths },
+  { STMarsCirceRememberRebirth, &marscirce_remember_rebirth },
+  { STMarsCirceRememberNoRebirth, &marscirce_remember_no_rebirth },
+  { STMarsCirceFixDeparture, &marscirce_fix_departure },
+  { STMarsCirceGenerateFromRebirthSquare, &marscirce_generate_from_rebirth_square },
+  { STMoveGeneratorRejectCaptures, &move_generation_reject_captures },
+  { STMoveGeneratorRejectNoncaptures, &move_generation_reject_non_captures },
+  { STVaultingKingsMovesForPieceGenerator, &vaulting_kings_generate_moves_for_piece },
+  { STTransmutingKingsMovesForPieceGenerator, &transmuting_kings_generate_moves_for_piece },
+  { STSuperTransmutingKingsMovesForPieceGenerator, &supertransmuting_kings_generate_moves_for_piece },
+  { STReflectiveKingsMovesForPieceGenerator, &reflective_kings_generate_moves_for_piece },
+  { STCastlingChessMovesForPieceGenerator, &castlingchess_generate_moves_for_piece },
+  { STPlatzwechselRochadeMovesForPieceGenerator, &exchange_castling_generate_moves_for_piece },
+  { STCastlingGenerator, &castling_generator_generate_castling },
+  { STMessignyMovesForPieceGenerator, &messigny_generate_moves_for_piece },
+  { STAnnanMovesForPieceGenerator, &annan_generate_moves_for_piece },
+  { STFaceToFaceMovesForPieceGenerator, &facetoface_generate_moves_for_piece },
+  { STBackToBackMovesForPieceGenerator, &backtoback_generate_moves_for_piece },
+  { STCheekToCheekMovesForPieceGenerator, &cheektocheek_generate_moves_for_piece },
+  { STMovesForPieceBasedOnWalkGenerator, &generate_moves_for_piece_based_on_walk_solve },
+  { STMoveGenerationPostMoveIterator, &move_generation_post_move_iterator_solve },
+
+  /* square observation */
+  { STIsSquareObservedOrtho, &is_square_observed_ortho_solve },
+  { STPlusIsSquareObserved, &plus_is_square_observed },
+  { STMarsIterateObservers, &marscirce_iterate_observers },
+  { STMarsCirceIsSquareObservedEnforceRexInclusive, &marscirce_is_square_observed_enforce_rex_exclusive },
+  { STMarsIsSquareObserved, &marscirce_is_square_observed },
+  { STVaultingKingIsSquareObserved, &vaulting_king_is_square_observed },
+  { STTransmutingKingIsSquareObserved, &transmuting_king_is_square_observed },
+  { STTransmutingKingDetectNonTransmutation, &transmuting_king_detect_non_transmutation },
+  { STDetermineObserverWalk, &determine_observer_walk },
+  { STBicoloresTryBothSides, &bicolores_try_both_sides },
+  { STDontTryObservingWithNonExistingWalk, &dont_try_observing_with_non_existing_walk },
+  { STDontTryObservingWithNonExistingWalkBothSides, &dont_try_observing_with_non_existing_walk_both_sides },
+  { STOptimiseObservationsByQueenInitialiser, &optimise_away_observations_by_queen_initialise },
+  { STOptimiseObservationsByQueen, &optimise_away_observations_by_queen },
+  { STTrackBackFromTargetAccordingToObserverWalk, &track_back_from_target_according_to_observer_walk },
+  { STIsSquareObservedTwoPaths, &is_square_observed_two_paths },
+  { STSquareObservationPostMoveIterator, &square_observation_post_move_iterator_solve }
+};
+
+enum
+{
+  nr_solvers = sizeof solvers / sizeof solvers[0]
+};
 
-    case STHauntedChessGhostSummoner:
-      haunted_chess_ghost_summoner_solve(si);
-      break;
+/* indexed by slice type; 0 for the types that aren't dispatched to */
+static solver_type solver_of_type[nr_slice_types];
 
-    case STHauntedChessGhostRememberer:
-      haunted_chess_ghost_rememberer_solve(si);
-      break;
+/* Initialise the dispatch table at start of program */
+void init_dispatch_table(void)
+{
+  unsigned int i;
 
-    case STGhostChessGhostRememberer:
-      ghost_chess_ghost_rememberer_solve(si);
-      break;
+  for (i = 0; i!=nr_solvers; ++i)
+  {
+    assert(solver_of_type[solvers[i].type]==0);
+    solver_of_type[solvers[i].type] = solvers[i].solver;
+  }
+}
 
-    case STAndernachSideChanger:
-      andernach_side_changer_solve(si);
-      break;
+/* Invoke the function implementing the type of a slice
+ * @param si slice index
+ */
+static void dispatch_to_solver(slice_index si)
+{
+  solver_type const solver = solver_of_type[SLICE_TYPE(si)];
+  assert(solver!=0);
+  (*solver)(si);
+}
 
-    case STAntiAndernachSideChanger:
-      antiandernach_side_changer_solve(si);
-      break;
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void dispatch(slice_index si)
+{
+  TraceEnumerator(slice_type,SLICE_TYPE(si));
+  TraceEOL();
 
-    case STChameleonPursuitSideChanger:
-      chameleon_pursuit_side_changer_solve(si);
-      break;
-
-    case STLostPiecesRemover:
-      lostpieces_remover_solve(si);
-      break;
-
-    case STNorskRemoveIllegalCaptures:
-      norsk_remove_illegal_captures_solve(si);
-      break;
-
-    case STNorskArrivingAdjuster:
-      norsk_arriving_adjuster_solve(si);
-      break;
-
-    case STProteanPawnAdjuster:
-      protean_pawn_adjuster_solve(si);
-      break;
-
-    case STEinsteinArrivingAdjuster:
-      einstein_moving_adjuster_solve(si);
-      break;
-
-    case STReverseEinsteinArrivingAdjuster:
-      reverse_einstein_moving_adjuster_solve(si);
-      break;
-
-    case STAntiEinsteinArrivingAdjuster:
-      anti_einstein_moving_adjuster_solve(si);
-      break;
-
-    case STTraitorSideChanger:
-      traitor_side_changer_solve(si);
-      break;
-
-    case STVolageSideChanger:
-      volage_side_changer_solve(si);
-      break;
-
-    case STMagicSquareSideChanger:
-    case STMagicSquareType2SideChanger:
-      magic_square_side_changer_solve(si);
-      break;
-
-    case STMagicSquareType2AnticirceRelevantSideAdapter:
-      magic_square_anticirce_relevant_side_adapter_solve(si);
-      break;
-
-    case STTibetSideChanger:
-      tibet_solve(si);
-      break;
-
-    case STDoubleTibetSideChanger:
-      double_tibet_solve(si);
-      break;
-
-    case STDegradierungDegrader:
-      degradierung_degrader_solve(si);
-      break;
-
-    case STChameleonChangePromoteeInto:
-      chameleon_change_promotee_into_solve(si);
-      break;
-
-    case STChameleonArrivingAdjuster:
-      chameleon_arriving_adjuster_solve(si);
-      break;
-
-    case STChameleonChessArrivingAdjuster:
-      chameleon_chess_arriving_adjuster_solve(si);
-      break;
-
-    case STLineChameleonArrivingAdjuster:
-      line_chameleon_arriving_adjuster_solve(si);
-      break;
-
-    case STFrischaufPromoteeMarker:
-      frischauf_promotee_marker_solve(si);
-      break;
-
-    case STPiecesHalfNeutralRecolorer:
-      half_neutral_recolorer_solve(si);
-      break;
-
-    case STKobulKingSubstitutor:
-      kobul_king_substitutor_solve(si);
-      break;
-
-    case STSnekSubstitutor:
-      snek_substitutor_solve(si);
-      break;
-
-    case STSnekCircleSubstitutor:
-      snek_circle_substitutor_solve(si);
-      break;
-
-    case STDuellistsRememberDuellist:
-      duellists_remember_duellist_solve(si);
-      break;
-
-    case STSingleboxType2LatentPawnSelector:
-      singlebox_type2_latent_pawn_selector_solve(si);
-      break;
-
-    case STSingleboxType2LatentPawnPromoter:
-      singlebox_type2_latent_pawn_promoter_solve(si);
-      break;
-
-    case STCirceKamikazeCaptureFork:
-      circe_kamikaze_capture_fork_solve(si);
-      break;
-
-    case STAnticirceInitialiseRebornFromCapturer:
-      circe_initialise_reborn_from_capturer_solve(si);
-      break;
-
-    case STMarscirceInitialiseRebornFromGenerated:
-      marscirce_initialise_reborn_from_generated_solve(si);
-      break;
-
-    case STGenevaInitialiseRebornFromCapturer:
-      geneva_initialise_reborn_from_capturer_solve(si);
-      break;
-
-    case STAnticirceCheylanFilter:
-      anticirce_cheylan_filter_solve(si);
-      break;
-
-    case STAnticirceRemoveCapturer:
-      anticirce_remove_capturer_solve(si);
-      break;
-
-    case STMarscirceRemoveCapturer:
-      marscirce_remove_capturer_solve(si);
-      break;
-
-    case STFootballChessSubsitutor:
-      football_chess_substitutor_solve(si);
-      break;
-
-    case STRefutationsCollector:
-      refutations_collector_solve(si);
-      break;
-
-    case STMinLengthGuard:
-      min_length_guard_solve(si);
-      break;
-
-    case STDegenerateTree:
-      degenerate_tree_solve(si);
-      break;
-
-    case STMaxNrNonTrivialCounter:
-      max_nr_nontrivial_counter_solve(si);
-      break;
-
-    case STKillerDefenseCollector:
-      killer_defense_collector_solve(si);
-      break;
-
-    case STFindByIncreasingLength:
-      find_by_increasing_length_solve(si);
-      break;
-
-    case STHelpMovePlayed:
-      help_move_played_solve(si);
-      break;
-
-    case STIntelligentMovesLeftInitialiser:
-      intelligent_moves_left_initialiser_solve(si);
-      break;
-
-    case STRestartGuardIntelligent:
-      restart_guard_intelligent_solve(si);
-      break;
-
-    case STIntelligentTargetCounter:
-      intelligent_target_counter_solve(si);
-      break;
-
-    case STIntelligentFilter:
-      intelligent_filter_solve(si);
-      break;
-
-    case STIntelligentFlightsGuarder:
-      intelligent_guard_flights(si);
-      break;
-
-    case STIntelligentFlightsBlocker:
-      intelligent_find_and_block_flights(si);
-      break;
-
-    case STIntelligentMateTargetPositionTester:
-      intelligent_mate_test_target_position(si);
-      break;
-
-    case STIntelligentStalemateTargetPositionTester:
-      intelligent_stalemate_test_target_position(si);
-      break;
-
-    case STIntelligentProof:
-      intelligent_proof_solve(si);
-      break;
-
-    case STIntelligentLimitNrSolutionsPerTargetPosLimiter:
-      intelligent_limit_nr_solutions_per_target_position_solve(si);
-      break;
-
-    case STGoalReachableGuardFilterMate:
-      goalreachable_guard_mate_solve(si);
-      break;
-
-    case STGoalReachableGuardFilterStalemate:
-      goalreachable_guard_stalemate_solve(si);
-      break;
-
-    case STGoalReachableGuardFilterProof:
-      goalreachable_guard_proofgame_solve(si);
-      break;
-
-    case STGoalReachableGuardFilterProofFairy:
-      goalreachable_guard_proofgame_fairy_solve(si);
-      break;
-
-    case STRestartGuard:
-      restart_guard_solve(si);
-      break;
-
-    case STRestartGuardNested:
-      restart_guard_nested_solve(si);
-      break;
-
-    case STMaxTimeProblemInstrumenter:
-      maxtime_problem_instrumenter_solve(si);
-      break;
-
-    case STMaxTimeSetter:
-      maxtime_set(si);
-      break;
-
-    case STMaxTimeGuard:
-      maxtime_guard_solve(si);
-      break;
-
-    case STMaxSolutionsProblemInstrumenter:
-      maxsolutions_problem_instrumenter_solve(si);
-      break;
-
-    case STMaxSolutionsSolvingInstrumenter:
-      maxsolutions_solving_instrumenter_solve(si);
-      break;
-
-    case STMaxSolutionsCounter:
-      maxsolutions_counter_solve(si);
-      break;
-
-    case STMaxSolutionsGuard:
-      maxsolutions_guard_solve(si);
-      break;
-
-    case STStopOnShortSolutionsSolvingInstrumenter:
-      stoponshortsolutions_solving_instrumenter_solve(si);
-      break;
-
-    case STStopOnShortSolutionsFilter:
-      stoponshortsolutions_solve(si);
-      break;
-
-    case STIfThenElse:
-      if_then_else_solve(si);
-      break;
-
-    case STFlightsquaresCounter:
-      flightsquares_counter_solve(si);
-      break;
-
-    case STKingMoveGenerator:
-      king_move_generator_solve(si);
-      break;
-
-    case STNonKingMoveGenerator:
-      non_king_move_generator_solve(si);
-      break;
-
-    case STUltraMummerMeasurerDeadend:
-      ultra_mummer_measurer_deadend_solve(si);
-      break;
-
-    case STLegalAttackCounter:
-    case STAnyMoveCounter:
-      legal_attack_counter_solve(si);
-      break;
-
-    case STLegalDefenseCounter:
-      legal_defense_counter_solve(si);
-      break;
-
-    case STCaptureCounter:
-      capture_counter_solve(si);
-      break;
-
-    case STOhneschachStopIfCheck:
-      ohneschach_stop_if_check_solve(si);
-      break;
-
-    case STOhneschachStopIfCheckAndNotMate:
-      ohneschach_stop_if_check_and_not_mate_solve(si);
-      break;
-
-    case STOhneschachDetectUndecidableGoal:
-      ohneschach_detect_undecidable_goal_solve(si);
-      break;
-
-    case STRecursionStopper:
-      recursion_stopper_solve(si);
-      break;
-
-    case STSinglePieceMoveGenerator:
-      single_piece_move_generator_solve(si);
-      break;
-
-    case STCastlingRightsAdjuster:
-      castling_rights_adjuster_solve(si);
-      break;
-
-    case STOpponentMovesCounter:
-      opponent_moves_counter_solve(si);
-      break;
-
-    case STOpponentMovesFewMovesPrioriser:
-      opponent_moves_few_moves_prioriser_solve(si);
-      break;
-
-    case STIntelligentImmobilisationCounter:
-      intelligent_immobilisation_counter_solve(si);
-      break;
-
-    case STIntelligentDuplicateAvoider:
-      intelligent_duplicate_avoider_solve(si);
-      break;
-
-    case STIntelligentSolutionRememberer:
-      intelligent_solution_rememberer_solve(si);
-      break;
-
-    case STIntelligentSolutionsPerTargetPosProblemInstrumenter:
-      intelligent_nr_solutions_per_target_position_problem_instrumenter_solve(si);
-      break;
-
-    case STIntelligentSolutionsPerTargetPosSolvingInstrumenter:
-      intelligent_nr_solutions_per_target_position_solving_instrumenter_solve(si);
-      break;
-
-    case STIntelligentSolutionsPerTargetPosInitialiser:
-      intelligent_nr_solutions_per_target_position_initialiser_solve(si);
-      break;
-
-    case STIntelligentSolutionsPerTargetPosCounter:
-      intelligent_nr_solutions_per_target_position_counter_solve(si);
-      break;
-
-    case STSetplayFork:
-      setplay_fork_solve(si);
-      break;
-
-    case STAttackAdapter:
-      attack_adapter_solve(si);
-      break;
-
-    case STDefenseAdapter:
-      defense_adapter_solve(si);
-      break;
-
-    case STHelpAdapter:
-      help_adapter_solve(si);
-      break;
-
-    case STAnd:
-      and_solve(si);
-      break;
-
-    case STNot:
-      not_solve(si);
-      break;
-
-    case STMoveInverter:
-    case STMoveInverterSetPlay:
-      move_inverter_solve(si);
-      break;
-
-    case STRetroStartRetractionPly:
-      retro_start_retraction_ply(si);
-      break;
-
-    case STRetroPlayNullMove:
-      retro_play_null_move(si);
-      break;
-
-    case STRetroRetractLastCapture:
-      circe_parrain_undo_retro_capture(si);
-      break;
-
-    case STRetroRedoLastCapture:
-      circe_parrain_redo_retro_capture(si);
-      break;
-
-    case STRetroUndoLastPawnMultistep:
-      en_passant_undo_multistep(si);
-      break;
-
-    case STRetroRedoLastPawnMultistep:
-      en_passant_redo_multistep(si);
-      break;
-
-    case STRetroStartRetroMovePly:
-      retro_start_retro_move_ply(si);
-      break;
-
-    case STMaxSolutionsInitialiser:
-      maxsolutions_initialiser_solve(si);
-      break;
-
-    case STStopOnShortSolutionsProblemInstrumenter:
-      stoponshortsolutions_problem_instrumenter_solve(si);
-      break;
-
-    case STStopOnShortSolutionsWasShortSolutionFound:
-      stoponshortsolutions_was_short_solution_found_solve(si);
-      break;
-
-    case STOutputPlaintextZeropositionIntroWriter:
-      output_plaintext_write_zeroposition_intro(si);
-      break;
-
-    case STOutputPlaintextTwinIntroWriter:
-      output_plaintext_write_twin_intro(si);
-      break;
-
-    case STOutputPlainTextMetaWriter:
-      output_plaintext_write_meta(si);
-      break;
-
-    case STOutputPlainTextBoardWriter:
-      output_plaintext_write_board(si);
-      break;
-
-    case STOutputPlainTextPieceCountsWriter:
-      output_plaintext_write_piece_counts(si);
-      break;
-
-    case STOutputPlainTextRoyalPiecePositionsWriter:
-      output_plaintext_write_royal_piece_positions(si);
-      break;
-
-    case STOutputPlainTextNonRoyalAttributesWriter:
-      output_plaintext_write_non_royal_attributes(si);
-      break;
-
-    case STOutputPlainTextConditionsWriter:
-      output_plaintext_write_conditions(si);
-      break;
-
-    case STOutputPlainTextMutuallyExclusiveCastlingsWriter:
-      output_plaintext_write_mutually_exclusive_castlings(si);
-      break;
-
-    case STOutputPlainTextDuplexWriter:
-      output_plaintext_write_duplex(si);
-      break;
-
-    case STOutputPlainTextHalfDuplexWriter:
-      output_plaintext_write_halfduplex(si);
-      break;
-
-    case STOutputPlainTextQuodlibetWriter:
-      output_plaintext_write_quodlibet(si);
-      break;
-
-    case STOutputPlainTextAToBIntraWriter:
-      output_plaintext_write_atob_intra(si);
-      break;
-
-    case STOutputPlainTextStipulationWriter:
-      output_plaintext_write_stipulation(si);
-      break;
-
-    case STOutputPlainTextGridWriter:
-      output_plaintext_write_grid(si);
-      break;
-
-    case STOutputPlainTextEndOfPositionWriters:
-      output_plaintext_end_of_position_writers_solve(si);
-      break;
-
-    case STZeroPositionInitialiser:
-      zeroposition_initialiser_solve(si);
-      break;
-
-    case STZeropositionSolvingStopper:
-      zeroposition_solving_stopper_solve(si);
-      break;
-
-    case STIllegalSelfcheckWriter:
-      illegal_selfcheck_writer_solve(si);
-      break;
-
-    case STOutputPlainTextEndOfPhaseWriter:
-      output_plaintext_end_of_phase_writer_solve(si);
-      break;
-
-    case STOutputPlaintextMoveInversionCounter:
-    case STOutputPlaintextMoveInversionCounterSetPlay:
-      output_plaintext_move_inversion_counter_solve(si);
-      break;
-
-    case STOutputPlaintextLineEndOfIntroSeriesMarker:
-      output_plaintext_line_end_of_intro_series_marker_solve(si);
-      break;
-
-    case STPiecesParalysingMateFilter:
-      paralysing_mate_filter_solve(si);
-      break;
-
-    case STPiecesParalysingStalemateSpecial:
-      paralysing_stalemate_special_solve(si);
-      break;
-
-    case STPiecesParalysingRemoveCaptures:
-      paralysing_remove_captures_solve(si);
-      break;
-
-    case STPiecesParalysingSuffocationFinder:
-      paralysing_suffocation_finder_solve(si);
-      break;
-
-    case STAmuMateFilter:
-      amu_mate_filter_solve(si);
-      break;
-
-    case STCirceSteingewinnFilter:
-      circe_steingewinn_filter_solve(si);
-      break;
-
-    case STCirceCircuitSpecial:
-      circe_circuit_special_solve(si);
-      break;
-
-    case STCirceExchangeSpecial:
-      circe_exchange_special_solve(si);
-      break;
-
-    case STTemporaryHackFork:
-      pipe_solve_delegate(si);
-      break;
-
-    case STGoalTargetReachedTester:
-      goal_target_reached_tester_solve(si);
-      break;
-
-    case STGoalCheckReachedTester:
-      goal_check_reached_tester_solve(si);
-      break;
-
-    case STGoalCaptureReachedTester:
-      goal_capture_reached_tester_solve(si);
-      break;
-
-    case STGoalSteingewinnReachedTester:
-      goal_steingewinn_reached_tester_solve(si);
-      break;
-
-    case STGoalEnpassantReachedTester:
-      goal_enpassant_reached_tester_solve(si);
-      break;
-
-    case STGoalDoubleMateReachedTester:
-      goal_doublemate_reached_tester_solve(si);
-      break;
-
-    case STGoalCounterMateReachedTester:
-      goal_countermate_reached_tester_solve(si);
-      break;
-
-    case STGoalCastlingReachedTester:
-      goal_castling_reached_tester_solve(si);
-      break;
-
-    case STGoalCircuitReachedTester:
-      goal_circuit_reached_tester_solve(si);
-      break;
-
-    case STGoalExchangeReachedTester:
-      goal_exchange_reached_tester_solve(si);
-      break;
-
-    case STGoalCircuitByRebirthReachedTester:
-      goal_circuit_by_rebirth_reached_tester_solve(si);
-      break;
-
-    case STGoalExchangeByRebirthReachedTester:
-      goal_exchange_by_rebirth_reached_tester_solve(si);
-      break;
-
-    case STGoalProofgameReachedTester:
-    case STGoalAToBReachedTester:
-      goal_proofgame_reached_tester_solve(si);
-      break;
-
-    case STGoalImmobileReachedTester:
-      goal_immobile_reached_tester_solve(si);
-      break;
-
-    case STMaffImmobilityTesterKing:
-      maff_immobility_tester_king_solve(si);
-      break;
-
-    case STOWUImmobilityTesterKing:
-      owu_immobility_tester_king_solve(si);
-      break;
-
-    case STGoalNotCheckReachedTester:
-      goal_notcheck_reached_tester_solve(si);
-      break;
-
-    case STGoalAnyReachedTester:
-      goal_any_reached_tester_solve(si);
-      break;
-
-    case STGoalChess81ReachedTester:
-      goal_chess81_reached_tester_solve(si);
-      break;
-
-    case STGoalKissReachedTester:
-      goal_kiss_reached_tester_solve(si);
-      break;
-
-    case STGoalKingCaptureReachedTester:
-      goal_king_capture_reached_tester_solve(si);
-      break;
-
-    case STPiecesParalysingMateFilterTester:
-      paralysing_mate_filter_tester_solve(si);
-      break;
-
-    case STBlackChecks:
-      blackchecks_solve(si);
-      break;
-
-    case STSingleBoxType1LegalityTester:
-      singlebox_type1_legality_tester_solve(si);
-      break;
-
-    case STSingleBoxType2LegalityTester:
-      singlebox_type2_legality_tester_solve(si);
-      break;
-
-    case STSingleBoxType3LegalityTester:
-      singlebox_type3_legality_tester_solve(si);
-      break;
-
-    case STSingleBoxType3PawnPromoter:
-      singlebox_type3_pawn_promoter_solve(si);
-      break;
-
-    case STExclusiveChessExclusivityDetector:
-      exclusive_chess_exclusivity_detector_solve(si);
-      break;
-
-    case STExclusiveChessNestedExclusivityDetector:
-      exclusive_chess_nested_exclusivity_detector_solve(si);
-      break;
-
-    case STExclusiveChessLegalityTester:
-      exclusive_chess_legality_tester_solve(si);
-      break;
-
-    case STExclusiveChessGoalReachingMoveCounter:
-      exclusive_chess_goal_reaching_move_counter_solve(si);
-      break;
-
-    case STExclusiveChessUndecidableWriterTree:
-      exclusive_chess_undecidable_writer_tree_solve(si);
-      break;
-
-    case STExclusiveChessUndecidableWriterLine:
-      exclusive_chess_undecidable_writer_line_solve(si);
-      break;
-
-    case STUltraschachzwangLegalityTester:
-      ultraschachzwang_legality_tester_solve(si);
-      break;
-
-    case STIsardamLegalityTester:
-      isardam_legality_tester_solve(si);
-      break;
-
-    case STCirceAssassinAssassinate:
-      circe_assassin_assassinate_solve(si);
-      break;
-
-    case STCirceParachuteRemember:
-      circe_parachute_remember_solve(si);
-      break;
-
-    case STCirceParachuteUncoverer:
-      circe_parachute_uncoverer_solve(si);
-      break;
-
-    case STCirceVolcanicRemember:
-      circe_volcanic_remember_solve(si);
-      break;
-
-    case STCirceVolcanicSwapper:
-      circe_volcanic_swapper_solve(si);
-      break;
-
-    case STKingSquareUpdater:
-      king_square_updater_solve(si);
-      break;
-
-    case STOwnKingCaptureAvoider:
-      own_king_capture_avoider_solve(si);
-      break;
-
-    case STOpponentKingCaptureAvoider:
-      opponent_king_capture_avoider_solve(si);
-      break;
-
-    case STPatienceChessLegalityTester:
-      patience_chess_legality_tester_solve(si);
-      break;
-
-    case STStrictSATInitialiser:
-      strict_sat_initialiser_solve(si);
-      break;
-
-    case STStrictSATUpdater:
-      strict_sat_updater_solve(si);
-      break;
-
-    case STDynastyKingSquareUpdater:
-      dynasty_king_square_updater_solve(si);
-      break;
-
-    case STHurdleColourChanger:
-      hurdle_colour_changer_solve(si);
-      break;
-
-    case STHurdleColourChangeInitialiser:
-      hurdle_colour_change_initialiser_solve(si);
-      break;
-
-    case STHurdleColourChangerChangePromoteeInto:
-      hurdle_colour_change_change_promotee_into_solve(si);
-      break;
-
-    case STOscillatingKingsTypeA:
-      oscillating_kings_type_a_solve(si);
-      break;
-
-    case STOscillatingKingsTypeB:
-      oscillating_kings_type_b_solve(si);
-      break;
-
-    case STOscillatingKingsTypeC:
-      oscillating_kings_type_c_solve(si);
-      break;
-
-    case STPlaySuppressor:
-      play_suppressor_solve(si);
-      break;
-
-    case STContinuationSolver:
-      continuation_solver_solve(si);
-      break;
-
-    case STDefensePlayed:
-      defense_played_solve(si);
-      break;
-
-    case STMaxFlightsquares:
-      maxflight_guard_solve(si);
-      break;
-
-    case STMaxNrNonTrivial:
-      max_nr_nontrivial_guard_solve(si);
-      break;
-
-    case STOutputPlainTextTreeEndOfSolutionWriter:
-      output_plaintext_end_of_solution_writer_solve(si);
-      break;
-
-    case STKillerMoveFinalDefenseMove:
-      killer_move_final_defense_move_solve(si);
-      break;
-
-    case STKillerMovePrioriser:
-      killer_move_prioriser_solve(si);
-      break;
-
-    case STMaxThreatLength:
-      maxthreatlength_guard_solve(si);
-      break;
-
-    case STKillerAttackCollector:
-      killer_attack_collector_solve(si);
-      break;
-
-    case STMummerOrchestrator:
-      mummer_orchestrator_solve(si);
-      break;
-
-    case STMummerBookkeeper:
-      mummer_bookkeeper_solve(si);
-      break;
-
-    case STBackHomeMovesOnly:
-      back_home_moves_only_solve(si);
-      break;
-
-    case STNoPromotionsRemovePromotionMoving:
-      nopromotion_avoid_promotion_moving_solve(si);
-      break;
-
-    case STBackhomeExistanceTester:
-      backhome_existance_tester_solve(si);
-      break;
-
-    case STBackhomeRemoveIllegalMoves:
-      backhome_remove_illegal_moves_solve(si);
-      break;
-
-    case STNocaptureRemoveCaptures:
-      nocapture_remove_captures_solve(si);
-      break;
-
-    case STWoozlesRemoveIllegalCaptures:
-      woozles_remove_illegal_captures_solve(si);
-      break;
-
-    case STBiWoozlesRemoveIllegalCaptures:
-      biwoozles_remove_illegal_captures_solve(si);
-      break;
-
-    case STHeffalumpsRemoveIllegalCaptures:
-      heffalumps_remove_illegal_captures_solve(si);
-      break;
-
-    case STBiHeffalumpsRemoveIllegalCaptures:
-      biheffalumps_remove_illegal_captures_solve(si);
-      break;
-
-    case STProvocateursRemoveUnobservedCaptures:
-      provocateurs_remove_unobserved_captures_solve(si);
-      break;
-
-    case STLortapRemoveSupportedCaptures:
-      lortap_remove_supported_captures_solve(si);
-      break;
-
-    case STPatrolRemoveUnsupportedCaptures:
-      patrol_remove_unsupported_captures_solve(si);
-      break;
-
-    case STKoekoLegalityTester:
-      koeko_legality_tester_solve(si);
-      break;
-
-    case STGridContactLegalityTester:
-      contact_grid_legality_tester_solve(si);
-      break;
-
-    case STAntiKoekoLegalityTester:
-      antikoeko_legality_tester_solve(si);
-      break;
-
-    case STNewKoekoRememberContact:
-      newkoeko_remember_contact_solve(si);
-      break;
-
-    case STNewKoekoLegalityTester:
-      newkoeko_legality_tester_solve(si);
-      break;
-
-    case STJiggerLegalityTester:
-      jigger_legality_tester_solve(si);
-      break;
-
-    case STMonochromeRemoveBichromeMoves:
-      monochrome_remove_bichrome_moves_solve(si);
-      break;
-
-    case STBichromeRemoveMonochromeMoves:
-      bichrome_remove_monochrome_moves_solve(si);
-      break;
-
-    case STEdgeMoverRemoveIllegalMoves:
-      edgemover_remove_illegal_moves_solve(si);
-      break;
-
-    case STShieldedKingsRemoveIllegalCaptures:
-      shielded_kings_remove_illegal_captures_solve(si);
-      break;
-
-    case STSuperguardsRemoveIllegalCaptures:
-      superguards_remove_illegal_captures_solve(si);
-      break;
-
-    case STGridRemoveIllegalMoves:
-      grid_remove_illegal_moves_solve(si);
-      break;
-
-    case STUncapturableRemoveCaptures:
-      uncapturable_remove_captures_solve(si);
-      break;
-
-    case STTakeAndMakeGenerateMake:
-      take_and_make_generate_make_solve(si);
-      break;
-
-    case STTakeAndMakeAvoidPawnMakeToBaseLine:
-      take_and_make_avoid_pawn_make_to_base_line_solve(si);
-      break;
-
-    case STWormholeRemoveIllegalCaptures:
-      wormhole_remove_illegal_captures_solve(si);
-      break;
-
-    case STWormholeTransferer:
-      wormhole_transferer_solve(si);
-      break;
-
-    case STExtinctionExtinctedTester:
-      extinction_extincted_tester_solve(si);
-      break;
-
-    case STCastlingGeneratorTestDeparture:
-      castling_generate_test_departure(si);
-      break;
-
-    case STBlackChecksNullMoveGenerator:
-      black_checks_null_move_generator_solve(si);
-      break;
-
-    case STTrue:
-      solve_result = previous_move_has_solved;
-      break;
-
-    case STFalse:
-      solve_result = MOVE_HAS_NOT_SOLVED_LENGTH();
-      break;
-
-    /* move generators: */
-    case STSingleBoxType3TMovesForPieceGenerator:
-      singleboxtype3_generate_moves_for_piece(si);
-      break;
-
-    case STMadrasiMovesForPieceGenerator:
-      madrasi_generate_moves_for_piece(si);
-      break;
-
-    case STPartialParalysisMovesForPieceGenerator:
-      partial_paralysis_generate_moves_for_piece(si);
-      break;
-
-    case STEiffelMovesForPieceGenerator:
-      eiffel_generate_moves_for_piece(si);
-      break;
-
-    case STDisparateMovesForPieceGenerator:
-      disparate_generate_moves_for_piece(si);
-      break;
-
-    case STParalysingMovesForPieceGenerator:
-      paralysing_generate_moves_for_piece(si);
-      break;
-
-    case STUltraPatrolMovesForPieceGenerator:
-      ultrapatrol_generate_moves_for_piece(si);
-      break;
-
-    case STCentralMovesForPieceGenerator:
-      central_generate_moves_for_piece(si);
-      break;
-
-    case STBeamtenMovesForPieceGenerator:
-      beamten_generate_moves_for_piece(si);
-      break;
-
-    case STMarsCirceMoveGeneratorEnforceRexInclusive:
-      marscirce_generate_moves_enforce_rex_exclusive(si);
-      break;
-
-    case STPhantomAvoidDuplicateMoves:
-      phantom_avoid_duplicate_moves(si);
-      break;
-
-    case STPlusAdditionalCapturesForPieceGenerator:
-      plus_generate_additional_captures_for_piece(si);
-      break;
-
-    case STMoveForPieceGeneratorTwoPaths:
-      generate_moves_for_piece_two_paths(si);
-      break;
-
-    case STMarsCirceRememberRebirth:
-      marscirce_remember_rebirth(si);
-      break;
-
-    case STMarsCirceRememberNoRebirth:
-      marscirce_remember_no_rebirth(si);
-      break;
-
-    case STMarsCirceFixDeparture:
-      marscirce_fix_departure(si);
-      break;
-
-    case STMarsCirceGenerateFromRebirthSquare:
-      marscirce_generate_from_rebirth_square(si);
-      break;
-
-    case STMoveGeneratorRejectCaptures:
-      move_generation_reject_captures(si);
-      break;
-
-    case STMoveGeneratorRejectNoncaptures:
-      move_generation_reject_non_captures(si);
-      break;
-
-    case STVaultingKingsMovesForPieceGenerator:
-      vaulting_kings_generate_moves_for_piece(si);
-      break;
-
-    case STTransmutingKingsMovesForPieceGenerator:
-      transmuting_kings_generate_moves_for_piece(si);
-      break;
-
-    case STSuperTransmutingKingsMovesForPieceGenerator:
-      supertransmuting_kings_generate_moves_for_piece(si);
-      break;
-
-    case STReflectiveKingsMovesForPieceGenerator:
-      reflective_kings_generate_moves_for_piece(si);
-      break;
-
-    case STCastlingChessMovesForPieceGenerator:
-      castlingchess_generate_moves_for_piece(si);
-      break;
-
-    case STPlatzwechselRochadeMovesForPieceGenerator:
-      exchange_castling_generate_moves_for_piece(si);
-      break;
-
-    case STCastlingGenerator:
-      castling_generator_generate_castling(si);
-      break;
-
-    case STMessignyMovesForPieceGenerator:
-      messigny_generate_moves_for_piece(si);
-      break;
-
-    case STAnnanMovesForPieceGenerator:
-      annan_generate_moves_for_piece(si);
-      break;
-
-    case STFaceToFaceMovesForPieceGenerator:
-      facetoface_generate_moves_for_piece(si);
-      break;
-
-    case STBackToBackMovesForPieceGenerator:
-      backtoback_generate_moves_for_piece(si);
-      break;
-
-    case STCheekToCheekMovesForPieceGenerator:
-      cheektocheek_generate_moves_for_piece(si);
-      break;
-
-    case STMovesForPieceBasedOnWalkGenerator:
-      generate_moves_for_piece_based_on_walk();
-      break;
-
-    case STMoveGenerationPostMoveIterator:
-      move_generation_post_move_iterator_solve(si);
-      break;
-
-    /* square observation */
-    case STIsSquareObservedOrtho:
-      observation_result = is_square_observed_ortho(trait[nbply],
-                                                    move_generation_stack[CURRMOVE_OF_PLY(nbply)].capture);
-      break;
-
-    case STPlusIsSquareObserved:
-      plus_is_square_observed(si);
-      break;
-
-    case STMarsIterateObservers:
-      marscirce_iterate_observers(si);
-      break;
-
-    case STMarsCirceIsSquareObservedEnforceRexInclusive:
-      marscirce_is_square_observed_enforce_rex_exclusive(si);
-      break;
-
-    case STMarsIsSquareObserved:
-      marscirce_is_square_observed(si);
-      break;
-
-    case STVaultingKingIsSquareObserved:
-      vaulting_king_is_square_observed(si);
-      break;
-
-    case STTransmutingKingIsSquareObserved:
-      transmuting_king_is_square_observed(si);
-      break;
-
-    case STTransmutingKingDetectNonTransmutation:
-      transmuting_king_detect_non_transmutation(si);
-      break;
-
-    case STDetermineObserverWalk:
-      determine_observer_walk(si);
-      break;
-
-    case STBicoloresTryBothSides:
-      bicolores_try_both_sides(si);
-      break;
-
-    case STDontTryObservingWithNonExistingWalk:
-      dont_try_observing_with_non_existing_walk(si);
-      break;
-
-    case STDontTryObservingWithNonExistingWalkBothSides:
-      dont_try_observing_with_non_existing_walk_both_sides(si);
-      break;
-
-    case STOptimiseObservationsByQueenInitialiser:
-      optimise_away_observations_by_queen_initialise(si);
-      break;
-
-    case STOptimiseObservationsByQueen:
-      optimise_away_observations_by_queen(si);
-      break;
-
-    case STTrackBackFromTargetAccordingToObserverWalk:
-      track_back_from_target_according_to_observer_walk(si);
-      break;
-
-    case STIsSquareObservedTwoPaths:
-      is_square_observed_two_paths(si);
-      break;
-
-    case STSquareObservationPostMoveIterator:
-      square_observation_post_move_iterator_solve(si);
-      break;
-
-    default:
-      assert(0);
-      break;
+  if (is_profiling)
+  {
+    profile_invocation_type invocation;
+    profile_enter_slice(si,&invocation);
+    dispatch_to_solver(si);
+    profile_leave_slice(&invocation);
   }
+  else
+    dispatch_to_solver(si);
 }
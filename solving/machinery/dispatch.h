@@ -7,6 +7,9 @@
 
 #include "stipulation/stipulation.h"
 
+/* Initialise the dispatch table at start of program */
+void init_dispatch_table(void);
+
 /* Perform a dispatch
  */
 void dispatch(slice_index si);
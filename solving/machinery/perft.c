@@ -0,0 +1,241 @@
+#include "solving/machinery/perft.h"
+#include "stipulation/stipulation.h"
+#include "stipulation/pipe.h"
+#include "stipulation/proxy.h"
+#include "stipulation/branch.h"
+#include "stipulation/slice_insertion.h"
+#include "stipulation/help_play/branch.h"
+#include "stipulation/goals/slice_insertion.h"
+#include "stipulation/goals/any/reached_tester.h"
+#include "solving/has_solution_type.h"
+#include "solving/ply.h"
+#include "solving/pipe.h"
+#include "output/output.h"
+#include "output/plaintext/plaintext.h"
+#include "output/plaintext/protocol.h"
+#include "output/plaintext/message.h"
+#include "platform/timer.h"
+#include "debugging/trace.h"
+
+unsigned int perft_depth;
+
+static unsigned long long nr_sequences;
+
+/* ply of the move at the root level */
+static ply root_ply;
+
+/* Determine the number of moves played since the root level
+ * @return number of moves, including the root move
+ */
+static unsigned int nr_moves_played(void)
+{
+  unsigned int result = 1;
+  ply p;
+
+  for (p = nbply; p!=root_ply; p = parent_ply[p])
+    ++result;
+
+  return result;
+}
+
+/* Request counting the sequences of legal moves
+ * @param depth number of half-moves; 0 and numbers exceeding the capacity of
+ *              the solving machinery are ignored
+ */
+void perft_request(unsigned int depth)
+{
+  if (depth<maxply/2)
+    perft_depth = depth;
+}
+
+/* Allocate the stipulation that replaces the problem's stipulation while
+ * counting
+ * @return identifier of the entry slice
+ */
+slice_index alloc_perft_stipulation(void)
+{
+  slice_index const selector = alloc_output_mode_selector(output_mode_none);
+  slice_index const proxy = alloc_proxy_slice();
+  slice_index const proxy_goal = alloc_proxy_slice();
+  slice_index const branch = alloc_help_branch(perft_depth,perft_depth);
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParamListEnd();
+
+  pipe_link(proxy_goal,alloc_goal_any_reached_tester_system());
+
+  link_to_branch(proxy,branch);
+  help_branch_set_end_goal(proxy,proxy_goal,1);
+
+  /* the sequences are counted, but not written */
+  pipe_link(selector,proxy);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResult("%u",selector);
+  TraceFunctionResultEnd();
+  return selector;
+}
+
+static void insert_root_move_writer(slice_index si, stip_structure_traversal *st)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  stip_traverse_structure_children_pipe(si,st);
+
+  if (st->level==structure_traversal_level_top)
+  {
+    slice_index const prototype = alloc_pipe(STPerftRootMoveWriter);
+    slice_insertion_insert(si,&prototype,1);
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+static void insert_sequence_counter(slice_index si, stip_structure_traversal *st)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  if (SLICE_U(si).goal_handler.goal.type==goal_any)
+  {
+    slice_index const prototype = alloc_pipe(STPerftSequenceCounter);
+    goal_branch_insert_slices(SLICE_NEXT2(si),&prototype,1);
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+static structure_traversers_visitor perft_counters_inserters[] =
+{
+  { STHelpAdapter,       &insert_root_move_writer              },
+  { STGoalReachedTester, &insert_sequence_counter              },
+  { STTemporaryHackFork, &stip_traverse_structure_children_pipe }
+};
+
+enum
+{
+  nr_perft_counters_inserters = (sizeof perft_counters_inserters
+                                 / sizeof perft_counters_inserters[0])
+};
+
+/* Instrument the solving machinery with the slices that count the sequences
+ * @param si identifies the root slice of the solving machinery
+ */
+void solving_insert_perft_counters(slice_index si)
+{
+  stip_structure_traversal st;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  stip_structure_traversal_init(&st,0);
+  stip_structure_traversal_override(&st,
+                                    perft_counters_inserters,
+                                    nr_perft_counters_inserters);
+  stip_traverse_structure(si,&st);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Count the sequences of a twin and write their total
+ * @param si slice index
+ */
+void perft_writer_solve(slice_index si)
+{
+  unsigned long long const start = platform_read_ticks();
+
+  nr_sequences = 0;
+
+  pipe_solve_delegate(si);
+
+  protocol_fprintf(stdout,"\nperft %u: %llu\n",perft_depth,nr_sequences);
+
+  if (!is_variable_output_suppressed)
+  {
+    unsigned long long const ticks_per_second = platform_get_ticks_per_second();
+    unsigned long long const ticks = platform_read_ticks()-start;
+    if (ticks_per_second!=0 && ticks!=0)
+      protocol_fprintf(stdout,"%.0f sequences per second\n",
+                       (double)nr_sequences*ticks_per_second/ticks);
+  }
+
+  protocol_fflush(stdout);
+}
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void perft_root_move_writer_solve(slice_index si)
+{
+  unsigned long long const nr_sequences_before = nr_sequences;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  root_ply = nbply;
+  pipe_solve_delegate(si);
+
+  /* the self-check guard follows further down the branch */
+  if (solve_result!=previous_move_is_illegal)
+  {
+    protocol_fputc('\n',stdout);
+    output_plaintext_write_move(&output_plaintext_engine,
+                                stdout,
+                                &output_plaintext_symbol_table);
+    protocol_fprintf(stdout," %llu",nr_sequences-nr_sequences_before);
+    protocol_fflush(stdout);
+  }
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void perft_sequence_counter_solve(slice_index si)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  /* goal any would end each sequence after its first move(s) */
+  if (nr_moves_played()==perft_depth)
+  {
+    ++nr_sequences;
+    pipe_solve_delegate(si);
+  }
+  else
+    solve_result = previous_move_has_not_solved;
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
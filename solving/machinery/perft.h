@@ -0,0 +1,73 @@
+#if !defined(SOLVING_MACHINERY_PERFT_H)
+#define SOLVING_MACHINERY_PERFT_H
+
+#include "solving/machinery/solve.h"
+
+/* Counting the sequences of legal moves of a given length (option -perft)
+ * - the stipulation of each twin is replaced by help play of the requested
+ *   number of half-moves ending in goal any; the side that starts the
+ *   stipulation makes the first move
+ * - the moves are generated, played and tested for legality by the regular
+ *   solving machinery, i.e. the fairy pieces and conditions of the problem
+ *   apply
+ * - for each twin, the number of sequences starting with each legal move and
+ *   their total (and the number of sequences counted per second) are written
+ *   instead of the solutions
+ */
+
+/* number of half-moves to be counted; 0 if not requested */
+extern unsigned int perft_depth;
+
+/* Request counting the sequences of legal moves
+ * @param depth number of half-moves; 0 and numbers exceeding the capacity of
+ *              the solving machinery are ignored
+ */
+void perft_request(unsigned int depth);
+
+/* Allocate the stipulation that replaces the problem's stipulation while
+ * counting
+ * @return identifier of the entry slice
+ */
+slice_index alloc_perft_stipulation(void);
+
+/* Instrument the solving machinery with the slices that count the sequences
+ * @param si identifies the root slice of the solving machinery
+ */
+void solving_insert_perft_counters(slice_index si);
+
+/* Count the sequences of a twin and write their total
+ * @param si slice index
+ */
+void perft_writer_solve(slice_index si);
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void perft_root_move_writer_solve(slice_index si);
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void perft_sequence_counter_solve(slice_index si);
+
+#endif
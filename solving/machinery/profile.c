@@ -0,0 +1,196 @@
+#include "solving/machinery/profile.h"
+#include "solving/machinery/twin.h"
+#include "stipulation/filter_fusion.h"
+#include "solving/pipe.h"
+#include "platform/timer.h"
+
+#include <stdio.h>
+#include <string.h>
+
+boolean is_profiling;
+
+typedef struct
+{
+    slice_type type;
+    unsigned long long nr_invocations;
+    unsigned long long ticks;
+    unsigned long long counters[nr_profile_counters];
+} profile_type;
+
+static char const * const counter_names[nr_profile_counters] =
+{
+  "hash_probes",
+  "hash_hits",
+  "generated_moves"
+};
+
+static FILE *profile_file;
+static unsigned int nr_profiles_written;
+
+static profile_type slice_profiles[max_nr_slices];
+static profile_type slice_type_profiles[nr_slice_types];
+
+static profile_invocation_type *current_invocation;
+
+/* Request profiling
+ * @param path path of the file to write the profile to
+ */
+void profile_request(char const *path)
+{
+  profile_close();
+
+  profile_file = fopen(path,"w");
+  if (profile_file==0)
+    fprintf(stderr,"Couldn't open profile file %s\n",path);
+  else
+  {
+    fputs("[",profile_file);
+    nr_profiles_written = 0;
+    is_profiling = true;
+  }
+}
+
+/* Write the end of the profile and close the file
+ */
+void profile_close(void)
+{
+  if (profile_file!=0)
+  {
+    fputs("\n]\n",profile_file);
+    fclose(profile_file);
+    profile_file = 0;
+    is_profiling = false;
+  }
+}
+
+/* Record the start of the invocation of a slice
+ * @param si identifies the slice
+ * @param invocation remembers the invocation until profile_leave_slice()
+ */
+void profile_enter_slice(slice_index si, profile_invocation_type *invocation)
+{
+  invocation->caller = current_invocation;
+  invocation->si = si;
+  invocation->type = SLICE_TYPE(si);
+  invocation->ticks_in_callees = 0;
+  current_invocation = invocation;
+
+  invocation->start = platform_read_ticks();
+}
+
+/* Record the end of the invocation of a slice
+ * @param invocation as passed to profile_enter_slice()
+ */
+void profile_leave_slice(profile_invocation_type *invocation)
+{
+  unsigned long long const ticks = platform_read_ticks()-invocation->start;
+  unsigned long long const own_ticks = ticks-invocation->ticks_in_callees;
+  profile_type * const slice_profile = &slice_profiles[invocation->si];
+  profile_type * const slice_type_profile = &slice_type_profiles[invocation->type];
+
+  /* slices deallocated while solving may be reallocated with a different type */
+  if (slice_profile->nr_invocations==0)
+    slice_profile->type = invocation->type;
+  else if (slice_profile->type!=invocation->type)
+    slice_profile->type = no_slice_type;
+
+  ++slice_profile->nr_invocations;
+  slice_profile->ticks += own_ticks;
+  ++slice_type_profile->nr_invocations;
+  slice_type_profile->ticks += own_ticks;
+
+  current_invocation = invocation->caller;
+  if (current_invocation!=0)
+    current_invocation->ticks_in_callees += ticks;
+}
+
+/* Increment a counter of the slice being invoked
+ * @param counter identifies the counter
+ */
+void profile_count(profile_counter_type counter)
+{
+  if (current_invocation!=0)
+  {
+    ++slice_profiles[current_invocation->si].counters[counter];
+    ++slice_type_profiles[current_invocation->type].counters[counter];
+  }
+}
+
+static void write_profile(char const *key_name, char const *key,
+                          profile_type const *profile,
+                          boolean *is_first)
+{
+  profile_counter_type counter;
+
+  fprintf(profile_file,"%s\n    {%s%s",*is_first ? "" : ",",key_name,key);
+  fprintf(profile_file,", \"invocations\": %llu",profile->nr_invocations);
+  fprintf(profile_file,", \"ticks\": %llu",profile->ticks);
+  for (counter = 0; counter!=nr_profile_counters; ++counter)
+    fprintf(profile_file,", \"%s\": %llu",
+            counter_names[counter],profile->counters[counter]);
+  fputs("}",profile_file);
+
+  *is_first = false;
+}
+
+static void write_profiles(void)
+{
+  boolean is_first;
+  char key[100];
+
+  fprintf(profile_file,"%s\n  {\"twin\": %lu",
+          nr_profiles_written==0 ? "" : ",",twin_id);
+  fprintf(profile_file,", \"ticks_per_second\": %llu",
+          platform_get_ticks_per_second());
+  fprintf(profile_file,", \"nr_slices_before_fusion\": %u",
+          nr_slices_before_fusion);
+  fprintf(profile_file,", \"nr_slices_after_fusion\": %u",
+          nr_slices_after_fusion);
+
+  fputs(",\n   \"slice_types\": [",profile_file);
+  is_first = true;
+  {
+    slice_type type;
+    for (type = 0; type!=nr_slice_types; ++type)
+      if (slice_type_profiles[type].nr_invocations>0)
+      {
+        snprintf(key,sizeof key,"\"%s\"",slice_type_names[type]);
+        write_profile("\"type\": ",key,&slice_type_profiles[type],&is_first);
+      }
+  }
+  fputs("\n   ]",profile_file);
+
+  fputs(",\n   \"slices\": [",profile_file);
+  is_first = true;
+  {
+    slice_index si;
+    for (si = 0; si!=max_nr_slices; ++si)
+      if (slice_profiles[si].nr_invocations>0)
+      {
+        profile_type const * const profile = &slice_profiles[si];
+        if (profile->type==no_slice_type)
+          snprintf(key,sizeof key,"%u, \"type\": null",si);
+        else
+          snprintf(key,sizeof key,"%u, \"type\": \"%s\"",
+                   si,slice_type_names[profile->type]);
+        write_profile("\"slice\": ",key,profile,&is_first);
+      }
+  }
+  fputs("\n   ]}",profile_file);
+
+  fflush(profile_file);
+  ++nr_profiles_written;
+}
+
+/* Profile solving a twin and write the profile
+ * @param si slice index
+ */
+void profile_writer_solve(slice_index si)
+{
+  memset(slice_profiles,0,sizeof slice_profiles);
+  memset(slice_type_profiles,0,sizeof slice_type_profiles);
+
+  pipe_solve_delegate(si);
+
+  write_profiles();
+}
@@ -0,0 +1,78 @@
+#if !defined(SOLVING_MACHINERY_PROFILE_H)
+#define SOLVING_MACHINERY_PROFILE_H
+
+#include "stipulation/stipulation.h"
+#include "utilities/boolean.h"
+
+/* Profiling of the solving machinery at runtime (option -profile)
+ * - for each twin, writes a record to a file in JSON format
+ * - the record holds the invocations and the time spent (excluding the slices
+ *   invoked from it) of each slice and each slice type, and the hash table
+ *   probes and generated moves counted while the slice was the innermost one
+ *   being invoked
+ * - the record also holds the number of slices that solving may pass through
+ *   before and after the adjacent filter slices have been fused
+ * - the worker processes started by option -threads aren't profiled
+ */
+
+extern boolean is_profiling;
+
+typedef enum
+{
+  profile_hash_probes,
+  profile_hash_hits,
+  profile_generated_moves,
+
+  nr_profile_counters
+} profile_counter_type;
+
+/* Remembers the invocation of a slice while it lasts
+ */
+typedef struct profile_invocation_type
+{
+    struct profile_invocation_type *caller;
+    slice_index si;
+    slice_type type;
+    unsigned long long start;
+    unsigned long long ticks_in_callees;
+} profile_invocation_type;
+
+/* Request profiling
+ * @param path path of the file to write the profile to
+ */
+void profile_request(char const *path);
+
+/* Write the end of the profile and close the file
+ */
+void profile_close(void);
+
+/* Record the start of the invocation of a slice
+ * @param si identifies the slice
+ * @param invocation remembers the invocation until profile_leave_slice()
+ */
+void profile_enter_slice(slice_index si, profile_invocation_type *invocation);
+
+/* Record the end of the invocation of a slice
+ * @param invocation as passed to profile_enter_slice()
+ */
+void profile_leave_slice(profile_invocation_type *invocation);
+
+/* Increment a counter of the slice being invoked
+ * @param counter identifies the counter
+ */
+void profile_count(profile_counter_type counter);
+
+/* Increment a counter of the slice being invoked if profiling is active
+ */
+#define PROFILE_COUNT(counter)          \
+  {                                     \
+    if (is_profiling)                   \
+      profile_count(counter);           \
+  }
+
+/* Profile solving a twin and write the profile
+ * @param si slice index
+ */
+void profile_writer_solve(slice_index si);
+
+#endif
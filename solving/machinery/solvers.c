@@ -1,5 +1,6 @@
 #include "solving/machinery/solvers.h"
 #include "solving/machinery/twin.h"
+#include "solving/machinery/perft.h"
 #include "pieces/pieces.h"
 #include "options/options.h"
 #include "conditions/conditions.h"
@@ -176,8 +177,12 @@
 #include "options/maxflightsquares.h"
 #include "options/nontrivial.h"
 #include "options/movenumbers.h"
+#include "options/movenumbers/root_move_splitter.h"
 #include "optimisations/count_nr_opponent_moves/move_generator.h"
 #include "optimisations/orthodox_mating_moves/orthodox_mating_moves_generation.h"
+#include "optimisations/orthodox_pins.h"
+#include "optimisations/observation_cache.h"
+#include "optimisations/proof_numbers.h"
 #include "optimisations/intelligent/limit_nr_solutions_per_target.h"
 #include "optimisations/goals/remove_non_reachers.h"
 #include "optimisations/detect_retraction.h"
@@ -586,9 +591,12 @@ void build_solvers1(slice_index si)
 
   solving_remove_irrelevant_constraints(si);
 
-  if (OptFlag[movenbr])
+  if (OptFlag[movenbr] || root_move_splitter_is_enabled())
     solving_insert_restart_guards(si);
 
+  if (perft_depth>0)
+    solving_insert_perft_counters(si);
+
   solving_insert_continuation_solvers(si);
 
   solving_insert_find_shortest_solvers(si);
@@ -756,11 +764,17 @@ void build_solvers2(slice_index si)
 
   solving_optimise_with_killer_moves(si);
 
+  if (OptFlag[proofnumbers])
+    solving_insert_proof_number_search(si);
+
   if (is_piece_neutral(some_pieces_flags))
     solving_optimise_by_detecting_retracted_moves(si);
 
   optimise_is_square_observed(si);
   optimise_is_in_check(si);
+  observation_cache_initialise();
+
+  solving_optimise_with_orthodox_pins(si);
 
   solving_impose_starter(si,SLICE_STARTER(si));
 
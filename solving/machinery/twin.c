@@ -220,6 +220,8 @@ static boolean locate_royals(void)
             && being_solved.number_of_pieces[king_side][King]==1)
           new_king_square[king_side] = s;
       }
+
+      calculate_position_hash_key(&being_solved);
     }
   }
   else if (CondFlag[losingchess] || CondFlag[extinction])
@@ -658,8 +658,11 @@ void move_effect_journal_do_side_change(move_effect_reason_type reason, square o
   entry->u.side_change.to = to;
 
   --being_solved.number_of_pieces[advers(to)][get_walk_of_piece_on_square(on)];
-  piece_change_side(&being_solved.spec[on]);
-  occupy_square(on,get_walk_of_piece_on_square(on),being_solved.spec[on]);
+  {
+    Flags spec = being_solved.spec[on];
+    piece_change_side(&spec);
+    replace_flags(on,spec);
+  }
   ++being_solved.number_of_pieces[to][get_walk_of_piece_on_square(on)];
 
   TraceFunctionExit(__func__);
@@ -675,8 +678,11 @@ static void undo_side_change(move_effect_journal_entry_type const *entry)
   TraceFunctionParamListEnd();
 
   --being_solved.number_of_pieces[advers(from)][get_walk_of_piece_on_square(on)];
-  piece_change_side(&being_solved.spec[on]);
-  occupy_square(on,get_walk_of_piece_on_square(on),being_solved.spec[on]);
+  {
+    Flags spec = being_solved.spec[on];
+    piece_change_side(&spec);
+    replace_flags(on,spec);
+  }
   ++being_solved.number_of_pieces[from][get_walk_of_piece_on_square(on)];
 
   TraceFunctionExit(__func__);
@@ -692,8 +698,11 @@ static void redo_side_change(move_effect_journal_entry_type const *entry)
   TraceFunctionParamListEnd();
 
   --being_solved.number_of_pieces[advers(to)][get_walk_of_piece_on_square(on)];
-  piece_change_side(&being_solved.spec[on]);
-  occupy_square(on,get_walk_of_piece_on_square(on),being_solved.spec[on]);
+  {
+    Flags spec = being_solved.spec[on];
+    piece_change_side(&spec);
+    replace_flags(on,spec);
+  }
   ++being_solved.number_of_pieces[to][get_walk_of_piece_on_square(on)];
 
   TraceFunctionExit(__func__);
@@ -843,7 +852,7 @@ void move_effect_journal_do_flags_change(move_effect_reason_type reason,
   if (TSTFLAG(being_solved.spec[on],Black))
     --being_solved.number_of_pieces[Black][get_walk_of_piece_on_square(on)];
 
-  being_solved.spec[on] = to;
+  replace_flags(on,to);
 
   if (TSTFLAG(being_solved.spec[on],White))
     ++being_solved.number_of_pieces[White][get_walk_of_piece_on_square(on)];
@@ -873,7 +882,7 @@ static void undo_flags_change(move_effect_journal_entry_type const *entry)
   if (TSTFLAG(being_solved.spec[on],Black))
     --being_solved.number_of_pieces[Black][get_walk_of_piece_on_square(on)];
 
-  being_solved.spec[on] = from;
+  replace_flags(on,from);
 
   if (TSTFLAG(being_solved.spec[on],White))
     ++being_solved.number_of_pieces[White][get_walk_of_piece_on_square(on)];
@@ -900,7 +909,7 @@ static void redo_flags_change(move_effect_journal_entry_type const *entry)
   if (TSTFLAG(being_solved.spec[on],Black))
     --being_solved.number_of_pieces[Black][get_walk_of_piece_on_square(on)];
 
-  being_solved.spec[on] = to;
+  replace_flags(on,to);
 
   if (TSTFLAG(being_solved.spec[on],White))
     ++being_solved.number_of_pieces[White][get_walk_of_piece_on_square(on)];
@@ -1085,9 +1094,10 @@ static void do_polish(void)
       if (!is_piece_neutral(being_solved.spec[*bnp]) && !is_square_empty(*bnp))
       {
         Side const to = TSTFLAG(being_solved.spec[*bnp],White) ? Black : White;
+        Flags spec = being_solved.spec[*bnp];
         --being_solved.number_of_pieces[advers(to)][get_walk_of_piece_on_square(*bnp)];
-        piece_change_side(&being_solved.spec[*bnp]);
-        occupy_square(*bnp,get_walk_of_piece_on_square(*bnp),being_solved.spec[*bnp]);
+        piece_change_side(&spec);
+        replace_flags(*bnp,spec);
         ++being_solved.number_of_pieces[to][get_walk_of_piece_on_square(*bnp)];
       }
   }
@@ -1193,6 +1203,8 @@ static void do_shift(square from, square to)
       being_solved.board[*bnp] = board[*bnp];
       being_solved.spec[*bnp] = spec[*bnp];
     }
+
+  calculate_position_hash_key(&being_solved);
 }
 
 /* Execute a twinning that shifts the entire position
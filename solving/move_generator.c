@@ -6,6 +6,7 @@
 #include "stipulation/pipe.h"
 #include "stipulation/proxy.h"
 #include "stipulation/binary.h"
+#include "solving/machinery/profile.h"
 #include "conditions/circe/circe.h"
 #include "output/plaintext/plaintext.h"
 #include "output/plaintext/pieces.h"
@@ -592,6 +593,7 @@ void push_move(void)
   TraceFunctionParamListEnd();
 
   INCREMENT_COUNTER(add_to_move_generation_stack);
+  PROFILE_COUNT(profile_generated_moves);
 
   assert(current_move[nbply]<toppile);
 
@@ -618,6 +620,7 @@ void push_move_capture_extra(square sq_capture)
   TraceFunctionParamListEnd();
 
   INCREMENT_COUNTER(add_to_move_generation_stack);
+  PROFILE_COUNT(profile_generated_moves);
 
   assert(current_move[nbply]<toppile);
 
@@ -644,6 +647,7 @@ void push_special_move(square sq_special)
   TraceFunctionParamListEnd();
 
   INCREMENT_COUNTER(add_to_move_generation_stack);
+  PROFILE_COUNT(profile_generated_moves);
 
   assert(current_move[nbply]<toppile);
 
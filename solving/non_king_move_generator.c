@@ -29,25 +29,19 @@ slice_index alloc_non_king_move_generator_slice(void)
   return result;
 }
 
-static boolean advance_departure_square(square const **next_square_to_try)
+static boolean advance_departure_square(square_set_type *squares_to_try)
 {
-  while (true)
+  while (*squares_to_try!=0)
   {
-    square const sq_departure = **next_square_to_try;
-    if (sq_departure==0)
-      break;
-    else
+    square const sq_departure = square_set_pop_first(squares_to_try);
+
+    if (TSTFLAG(being_solved.spec[sq_departure],trait[nbply])
+      /* don't use king_square[side] - it may be a royal square occupied
+       * by a non-royal piece! */
+           && !TSTFLAG(being_solved.spec[sq_departure],Royal))
     {
-      ++*next_square_to_try;
-
-      if (TSTFLAG(being_solved.spec[sq_departure],trait[nbply])
-        /* don't use king_square[side] - it may be a royal square occupied
-         * by a non-royal piece! */
-             && !TSTFLAG(being_solved.spec[sq_departure],Royal))
-      {
-        generate_moves_for_piece(sq_departure);
-        return true;
-      }
+      generate_moves_for_piece(sq_departure);
+      return true;
     }
   }
 
@@ -69,7 +63,7 @@ static boolean advance_departure_square(square const **next_square_to_try)
  */
 void non_king_move_generator_solve(slice_index si)
 {
-  square const *next_square_to_try = boardnum;
+  square_set_type squares_to_try;
 
   TraceFunctionEntry(__func__);
   TraceFunctionParam("%u",si);
@@ -79,8 +73,10 @@ void non_king_move_generator_solve(slice_index si)
 
   nextply(SLICE_STARTER(si));
 
+  squares_to_try = get_squares_occupied_by(trait[nbply]);
+
   while (solve_result<slack_length
-         && advance_departure_square(&next_square_to_try))
+         && advance_departure_square(&squares_to_try))
     pipe_solve_delegate(si);
 
   finply();
@@ -35,6 +35,7 @@
 #include "conditions/transmuting_kings/reflective_kings.h"
 #include "conditions/transmuting_kings/vaulting_kings.h"
 #include "optimisations/observation.h"
+#include "optimisations/observation_cache.h"
 #include "pieces/walks/hunters.h"
 #include "pieces/attributes/paralysing/paralysing.h"
 #include "pieces/attributes/magic.h"
@@ -672,7 +673,11 @@ boolean is_square_observed_general(Side side, square s, validator_id evaluate)
 
   siblingply(side);
   push_observation_target(s);
-  result = is_square_observed(evaluate);
+  if (!observation_cache_lookup(Empty,evaluate,&result))
+  {
+    result = is_square_observed(evaluate);
+    observation_cache_remember(Empty,evaluate,result);
+  }
   finply();
 
   TraceFunctionExit(__func__);
@@ -158,6 +158,29 @@ static boolean compareImitators(void)
   return result;
 }
 
+/* Determine the squares where the current position differs from the target
+ * position in the side of the piece or in its walk (if orthodox).
+ * The sets of squares compared are kept up to date by the move effect journal,
+ * so this is cheap enough to be done at each node.
+ * @return the set of squares; the empty set if the pieces of the current
+ *         position are on their target squares (the positions may still
+ *         differ in fairy walks or in piece flags other than the side)
+ */
+square_set_type proof_squares_differing_from_target(void)
+{
+  square_set_type result = ((being_solved.occupied[White]
+                             ^proofgames_target_position.occupied[White])
+                            | (being_solved.occupied[Black]
+                               ^proofgames_target_position.occupied[Black]));
+  piece_walk_type p;
+
+  for (p = King; p<=Bishop; ++p)
+    result |= (being_solved.occupied_by_walk[p]
+               ^proofgames_target_position.occupied_by_walk[p]);
+
+  return result;
+}
+
 /* function that compares the current position with the desired one
  * and returns true if they are identical. Otherwise it returns false.
  */
@@ -168,7 +191,12 @@ boolean ProofIdentical(void)
   TraceFunctionEntry(__func__);
   TraceFunctionParamListEnd();
 
-  result = compareProofPieces() && compareProofNbrPiece() && compareImitators();
+  /* if a piece is missing from its target square or a piece occupies a square
+   * that is empty in the target position, the positions can't be identical */
+  result = (proof_squares_differing_from_target()==0
+            && compareProofPieces()
+            && compareProofNbrPiece()
+            && compareImitators());
 
   TraceFunctionExit(__func__);
   TraceFunctionResult("%u",result);
@@ -313,6 +341,8 @@ void proof_initialise_start_position(slice_index si)
   override_standard_walk(square_g7,Black,Pawn);
   override_standard_walk(square_h7,Black,Pawn);
 
+  calculate_position_hash_key(&proofgames_start_position);
+
   pipe_solve_delegate(si);
 
   TraceFunctionExit(__func__);
@@ -23,6 +23,14 @@ extern position proofgames_target_position;
 void ProofSaveStartPosition(void);
 void ProofRestoreStartPosition(void);
 
+/* Determine the squares where the current position differs from the target
+ * position in the side of the piece or in its walk (if orthodox).
+ * @return the set of squares; the empty set if the pieces of the current
+ *         position are on their target squares (the positions may still
+ *         differ in fairy walks or in piece flags other than the side)
+ */
+square_set_type proof_squares_differing_from_target(void);
+
 /* Compare two positions
  * @return true iff the current position is equal to the target
  *              position
@@ -68,8 +68,10 @@ static slice_index const slice_rank_order[] =
   STDegenerateTree,
   STFindShortest,
   STDeadEnd,
+  STProofNumberAttackNode,
   STLearnUnsolvable,
   STShortSolutionsStart,
+  STRootMoveSplitter,
   STGeneratingMoves,
   STExecutingKingCapture,
   STExclusiveChessExclusivityDetector,
@@ -107,6 +109,7 @@ static slice_index const slice_rank_order[] =
   STPiecesParalysingSuffocationFinder,
   STPiecesParalysingRemoveCaptures,
   STMummerOrchestrator,
+  STOrthodoxPinsDetector,
   STDoneRemovingIllegalMoves,
   STEnPassantRemoveNonReachers,
   STCastlingRemoveNonReachers,
@@ -116,6 +119,7 @@ static slice_index const slice_rank_order[] =
   STCageCirceFutileCapturesRemover,
   STDoneRemovingFutileMoves,
   STRetractionPrioriser,
+  STHistoryMovePrioriser,
   STKillerMovePrioriser,
   STDonePriorisingMoves,
   STMove,
@@ -135,10 +139,12 @@ static slice_index const slice_rank_order[] =
   STNotEndOfBranchGoal,
   STDeadEndGoal,
   STSelfCheckGuard,
+  STOrthodoxSelfCheckGuard,
   STOhneschachStopIfCheck,
   STOhneschachStopIfCheckAndNotMate,
   STLegalAttackCounter,
   STMummerDeadend,
+  STProofNumberDefenseNode,
 
   STDefenseAdapter,
   STEndOfIntro,
@@ -221,10 +227,12 @@ static slice_index const slice_rank_order[] =
   STShieldedKingsRemoveIllegalCaptures,
   STSuperguardsRemoveIllegalCaptures,
   STMummerOrchestrator,
+  STOrthodoxPinsDetector,
   STDoneRemovingIllegalMoves,
   STCageCirceFutileCapturesRemover,
   STDoneRemovingFutileMoves,
   STRetractionPrioriser,
+  STHistoryMovePrioriser,
   STKillerMovePrioriser,
   STOpponentMovesFewMovesPrioriser,
   STDonePriorisingMoves,
@@ -246,6 +254,7 @@ static slice_index const slice_rank_order[] =
   STEndOfBranchGoal,
   STNotEndOfBranchGoal,
   STSelfCheckGuard,
+  STOrthodoxSelfCheckGuard,
   STOhneschachStopIfCheck,
   STOhneschachStopIfCheckAndNotMate,
   STLegalDefenseCounter,
@@ -0,0 +1,287 @@
+#include "stipulation/filter_fusion.h"
+#include "stipulation/stipulation.h"
+#include "stipulation/pipe.h"
+#include "optimisations/orthodox_pins.h"
+#include "pieces/walks/pawns/en_passant.h"
+#include "solving/castling.h"
+#include "solving/check.h"
+#include "solving/move_effect_journal.h"
+#include "solving/has_solution_type.h"
+#include "solving/pipe.h"
+#include "debugging/trace.h"
+
+#include "debugging/assert.h"
+
+unsigned int nr_slices_before_fusion;
+unsigned int nr_slices_after_fusion;
+
+/* number of links to each slice */
+static unsigned int nr_references[max_nr_slices];
+
+/* Determine whether slices of a type can be fused
+ * @param type slice type
+ * @return true iff fused_filters_solve() knows how to do what slices of type
+ *         type do before delegating, and they don't do anything afterwards
+ *         (except for restoring king_square_horizon)
+ */
+static boolean is_fusible(slice_type type)
+{
+  switch (type)
+  {
+    case STEnPassantAdjuster:
+    case STKingSquareUpdater:
+    case STCastlingRightsAdjuster:
+    case STSelfCheckGuard:
+    case STOrthodoxSelfCheckGuard:
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+static void add_reference(slice_index si)
+{
+  if (si!=no_slice)
+    ++nr_references[si];
+}
+
+/* Count the links to each slice. All the allocated slices are taken into
+ * account (not only those reachable from the STFilterFuser slice) so that
+ * slices that are deallocated by the fusion aren't reachable by the
+ * deallocation of the solving machinery either.
+ */
+static void count_references(void)
+{
+  slice_index i;
+
+  for (i = 0; i!=max_nr_slices; ++i)
+    nr_references[i] = 0;
+
+  for (i = 0; i!=max_nr_slices; ++i)
+    if (is_slice_allocated(i))
+    {
+      add_reference(SLICE_NEXT1(i));
+      add_reference(SLICE_NEXT2(i));
+      add_reference(SLICE_TESTER(i));
+      if (SLICE_TYPE(i)==STIfThenElse)
+        add_reference(SLICE_U(i).if_then_else.condition);
+    }
+}
+
+/* Replace a run of adjacent filter slices by an STFusedFilters slice
+ * @param first first slice of the run; becomes the STFusedFilters slice
+ * @param last last slice of the run
+ * @param filters types of the slices of the run
+ * @param nr_filters number of slices of the run
+ */
+static void replace_run(slice_index first, slice_index last,
+                        slice_type const filters[], unsigned int nr_filters)
+{
+  slice_index const exit = SLICE_NEXT1(last);
+  slice_index const fused = alloc_pipe(STFusedFilters);
+  slice_index si;
+  unsigned int i;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",first);
+  TraceFunctionParam("%u",last);
+  TraceFunctionParam("%u",nr_filters);
+  TraceFunctionParamListEnd();
+
+  SLICE_STARTER(fused) = SLICE_STARTER(first);
+  for (i = 0; i!=max_nr_fused_filters; ++i)
+    SLICE_U(fused).fused_filters.filters[i] = i<nr_filters ? filters[i] : no_slice_type;
+
+  /* only first is linked to from outside the run */
+  si = SLICE_NEXT1(first);
+  while (si!=exit)
+  {
+    slice_index const next = SLICE_NEXT1(si);
+    dealloc_slice(si);
+    si = next;
+  }
+
+  pipe_substitute(first,fused);
+
+  if (SLICE_PREV(exit)==last)
+    pipe_link(first,exit);
+  else
+    pipe_set_successor(first,exit);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+static void fuse(slice_index si, stip_structure_traversal *st)
+{
+  slice_type filters[max_nr_fused_filters];
+  unsigned int nr_filters = 1;
+  slice_index last = si;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  filters[0] = SLICE_TYPE(si);
+
+  while (nr_filters<max_nr_fused_filters
+         && SLICE_NEXT1(last)!=no_slice
+         && is_fusible(SLICE_TYPE(SLICE_NEXT1(last)))
+         && SLICE_STARTER(SLICE_NEXT1(last))==SLICE_STARTER(si)
+         && nr_references[SLICE_NEXT1(last)]==1)
+  {
+    last = SLICE_NEXT1(last);
+    filters[nr_filters] = SLICE_TYPE(last);
+    ++nr_filters;
+  }
+
+  TraceValue("%u",nr_filters);
+  TraceEOL();
+
+  if (nr_filters>1)
+    replace_run(si,last,filters,nr_filters);
+
+  stip_traverse_structure_children_pipe(si,st);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+static void count_slice(slice_index si, stip_structure_traversal *st)
+{
+  unsigned int * const nr_slices = st->param;
+
+  ++*nr_slices;
+  stip_traverse_structure_children(si,st);
+}
+
+/* Count the slices that solving may pass through
+ * @param si identifies the entry slice
+ * @return number of slices
+ */
+static unsigned int count_slices(slice_index si)
+{
+  unsigned int result = 0;
+  stip_structure_traversal st;
+  unsigned int i;
+
+  stip_structure_traversal_init(&st,&result);
+  for (i = 0; i!=nr_slice_structure_types; ++i)
+    stip_structure_traversal_override_by_structure(&st,i,&count_slice);
+  stip_traverse_structure(si,&st);
+
+  return result;
+}
+
+/* Fuse the adjacent filter slices of the solving machinery, then solve
+ * @param si identifies the STFilterFuser slice
+ */
+void filters_fuse(slice_index si)
+{
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  nr_slices_before_fusion = count_slices(si);
+
+  {
+    stip_structure_traversal st;
+
+    count_references();
+
+    stip_structure_traversal_init(&st,0);
+    stip_structure_traversal_override_single(&st,STEnPassantAdjuster,&fuse);
+    stip_structure_traversal_override_single(&st,STKingSquareUpdater,&fuse);
+    stip_structure_traversal_override_single(&st,STCastlingRightsAdjuster,&fuse);
+    stip_structure_traversal_override_single(&st,STSelfCheckGuard,&fuse);
+    stip_structure_traversal_override_single(&st,STOrthodoxSelfCheckGuard,&fuse);
+    stip_traverse_structure(si,&st);
+  }
+
+  nr_slices_after_fusion = count_slices(si);
+
+  TraceValue("%u",nr_slices_before_fusion);
+  TraceValue("%u",nr_slices_after_fusion);
+  TraceEOL();
+
+  TraceStipulation(si);
+
+  pipe_solve_delegate(si);
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void fused_filters_solve(slice_index si)
+{
+  /* cf. king_square_updater_solve() */
+  move_effect_journal_index_type const save_horizon = king_square_horizon;
+  Side const starter = SLICE_STARTER(si);
+  slice_type const * const filters = SLICE_U(si).fused_filters.filters;
+  boolean is_legal = true;
+  unsigned int i;
+
+  TraceFunctionEntry(__func__);
+  TraceFunctionParam("%u",si);
+  TraceFunctionParamListEnd();
+
+  for (i = 0;
+       i!=max_nr_fused_filters && filters[i]!=no_slice_type && is_legal;
+       ++i)
+    switch (filters[i])
+    {
+      case STEnPassantAdjuster:
+        en_passant_adjust();
+        break;
+
+      case STKingSquareUpdater:
+        update_king_squares();
+        break;
+
+      case STCastlingRightsAdjuster:
+        adjust_castling_rights(starter);
+        break;
+
+      case STSelfCheckGuard:
+        if (is_in_check(advers(starter)))
+        {
+          solve_result = previous_move_is_illegal;
+          is_legal = false;
+        }
+        break;
+
+      case STOrthodoxSelfCheckGuard:
+        if (orthodox_is_in_selfcheck(advers(starter)))
+        {
+          solve_result = previous_move_is_illegal;
+          is_legal = false;
+        }
+        break;
+
+      default:
+        assert(0);
+        break;
+    }
+
+  if (is_legal)
+    pipe_solve_delegate(si);
+
+  king_square_horizon = save_horizon;
+
+  TraceFunctionExit(__func__);
+  TraceFunctionResultEnd();
+}
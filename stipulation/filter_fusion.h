@@ -0,0 +1,42 @@
+#if !defined(STIPULATION_FILTER_FUSION_H)
+#define STIPULATION_FILTER_FUSION_H
+
+#include "solving/machinery/solve.h"
+
+/* Fusion of adjacent filter slices
+ * Once the solving machinery has been built and its proxy slices have been
+ * resolved, each sequence of adjacent slices that only adjust the position
+ * after a move has been played or only test the legality of the move is
+ * replaced by a single STFusedFilters slice. The STFusedFilters slice
+ * performs the adjustments and tests of the slices it replaces in a loop,
+ * saving the dispatches to the replaced slices.
+ * The number of slices that solving may pass through before and after the
+ * fusion is written to the profile (option -profile).
+ */
+
+/* number of slices reachable before and after the fusion in the current
+ * twin */
+extern unsigned int nr_slices_before_fusion;
+extern unsigned int nr_slices_after_fusion;
+
+/* Fuse the adjacent filter slices of the solving machinery, then solve
+ * @param si identifies the STFilterFuser slice
+ */
+void filters_fuse(slice_index si);
+
+/* Try to solve in solve_nr_remaining half-moves.
+ * @param si slice index
+ * @note assigns solve_result the length of solution found and written, i.e.:
+ *            previous_move_is_illegal the move just played is illegal
+ *            this_move_is_illegal     the move being played is illegal
+ *            immobility_on_next_move  the moves just played led to an
+ *                                     unintended immobility on the next move
+ *            <=n+1 length of shortest solution found (n+1 only if in next
+ *                                     branch)
+ *            n+2 no solution found in this branch
+ *            n+3 no solution found in next branch
+ *            (with n denominating solve_nr_remaining)
+ */
+void fused_filters_solve(slice_index si);
+
+#endif
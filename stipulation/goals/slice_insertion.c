@@ -43,10 +43,12 @@ static slice_index const goal_slice_rank_order[] =
   STPiecesParalysingStalemateSpecial,
   STGoalCheckReachedTester,
   STSelfCheckGuard,
+  STOrthodoxSelfCheckGuard,
   STOhneschachStopIfCheckAndNotMate,
   STMummerDeadend,
   STGoalNotCheckReachedTester,
   STGoalImmobileReachedTester,
+  STPerftSequenceCounter,
   STTrue
 };
 
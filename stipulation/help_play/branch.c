@@ -28,6 +28,7 @@ static slice_index const slice_rank_order[] =
   STStopOnShortSolutionsFilter,
   STIntelligentMovesLeftInitialiser,
   STRestartGuardIntelligent,
+  STIntelligentTargetPositionSplitter,
   STIntelligentFilter,
   STMaxTimeGuard,
   STMaxSolutionsGuard,
@@ -60,6 +61,7 @@ static slice_index const slice_rank_order[] =
   STCastlingFilter,
   STPrerequisiteOptimiser,
   STDeadEnd,
+  STRootMoveSplitter,
   STGeneratingMoves,
   STExecutingKingCapture,
   STExclusiveChessExclusivityDetector,
@@ -98,6 +100,7 @@ static slice_index const slice_rank_order[] =
   STShieldedKingsRemoveIllegalCaptures,
   STSuperguardsRemoveIllegalCaptures,
   STMummerOrchestrator,
+  STOrthodoxPinsDetector,
   STDoneRemovingIllegalMoves,
   STEnPassantRemoveNonReachers,
   STCastlingRemoveNonReachers,
@@ -116,6 +119,7 @@ static slice_index const slice_rank_order[] =
   STMaxSolutionsGuard,
   STRestartGuardNested,
   STRestartGuard,
+  STPerftRootMoveWriter,
   STKeepMatingFilter,
   STIntelligentLimitNrSolutionsPerTargetPosLimiter,
   STGoalReachableGuardFilterMate,
@@ -131,6 +135,7 @@ static slice_index const slice_rank_order[] =
   STNotEndOfBranchGoal,
   STDeadEndGoal,
   STSelfCheckGuard,
+  STOrthodoxSelfCheckGuard,
   STOhneschachStopIfCheck,
   STOhneschachStopIfCheckAndNotMate,
   STMummerDeadend,
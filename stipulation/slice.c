@@ -238,6 +238,7 @@ static slice_type const move_reordering_optimiser_slice_types[] =
 {
     STOpponentMovesFewMovesPrioriser,
     STKillerMovePrioriser,
+    STHistoryMovePrioriser,
     STRetractionPrioriser
 };
 
@@ -715,12 +715,15 @@ static slice_index const slice_rank_order[] =
 #if defined(DOMEASURE)
   STCountersWriter,
 #endif
+  STProfileWriter,
+  STPerftWriter,
   STInputVerification,
   STMoveEffectsJournalReset,
   STSolversBuilder1,
   STOutputPlainTextInstrumentSolvers,
   STOutputLaTeXInstrumentSolvers,
   STSolversBuilder2,
+  STProofNumberTableOpener,
   STHashOpener,
   STMaxSolutionsSolvingInstrumenter,
   STStopOnShortSolutionsSolvingInstrumenter,
@@ -728,6 +731,7 @@ static slice_index const slice_rank_order[] =
   STSlackLengthAdjuster,
   STMaxTimeSetter,
   STProxyResolver,
+  STFilterFuser,
   STTemporaryHackFork,
   STStrictSATInitialiser,
   STHurdleColourChangeInitialiser,
@@ -745,6 +749,7 @@ static slice_index const slice_rank_order[] =
   STRetroRedoLastPawnMultistep,
   STIllegalSelfcheckWriter,
   STSelfCheckGuard,
+  STOrthodoxSelfCheckGuard,
   STMaxSolutionsInitialiser,
   STStopOnShortSolutionsWasShortSolutionFound,
   STMagicViewsInitialiser,
@@ -32,6 +32,15 @@ static boolean are_pieceids_required;
  */
 static boolean is_slice_index_allocated[max_nr_slices];
 
+/* Determine whether a slice index is allocated
+ * @param si slice index
+ * @return true iff si is allocated
+ */
+boolean is_slice_allocated(slice_index si)
+{
+  return is_slice_index_allocated[si];
+}
+
 /* Make sure that there are now allocated slices that are not
  * reachable
  */
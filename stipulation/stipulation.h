@@ -39,6 +39,11 @@ typedef enum
   twin_regular /* add 0 for a), 1 for b) etc. */
 } twinning_event_type;
 
+enum
+{
+  max_nr_fused_filters = 3
+};
+
 typedef struct
 {
     slice_type type;
@@ -150,6 +155,11 @@ typedef struct
                             twinning_event_type event,
                             boolean continued);
         } twinning_event_handler;
+
+        struct /* for type==STFusedFilters */
+        {
+            slice_type filters[max_nr_fused_filters]; /* no_slice_type if unused */
+        } fused_filters;
     } u;
 } Slice;
 
@@ -178,6 +188,12 @@ extern Slice slices[max_nr_slices];
  */
 void dealloc_slice(slice_index si);
 
+/* Determine whether a slice index is allocated
+ * @param si slice index
+ * @return true iff si is allocated
+ */
+boolean is_slice_allocated(slice_index si);
+
 /* Make sure that there are now allocated slices that are not
  * reachable
  */